@@ -1,12 +1,24 @@
+#include "util/allocation_counter.h"
+#include "util/audio_manager.h"
+#include "util/audio_sink.h"
+#include "util/benchmarks.h"
 #include "util/game.h"
 #include "util/logging.h"
 #include "util/gl_debug.h"
+#include "util/latency_probe.h"
+#include "util/level_format.h"
+#include "util/mixer_audio_backend.h"
 #include "util/resource_mgr.h"
 #include "util/reset_gl_properties.h"
+#include "util/settings_manager.h"
+#include "util/shader_cache.h"
+#include "util/worker_pool.h"
 
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 
 using namespace util;
@@ -15,6 +27,11 @@ using namespace util;
 void framebuffer_size_callback(GLFWwindow *window, int width, int height);
 void key_callback(GLFWwindow *window, int key, int scancode, int action, int mode);
 
+// true if any argument is option
+bool has_option(int argc, char *argv[], const char *option);
+// the argument following option, or nullptr if option isn't given (or is last)
+const char *option_value(int argc, char *argv[], const char *option);
+
 // width of screen
 constexpr unsigned int kScreenWidth{ 800 };
 constexpr unsigned int kScreenHeight{ 600 };
@@ -31,12 +48,110 @@ private:
 	{
 		glViewport(0, 0, kScreenWidth, kScreenHeight);
 	}
+
+	Viewport viewport_impl() const override
+	{
+		return{ 0, 0, static_cast<int>(kScreenWidth), static_cast<int>(kScreenHeight) };
+	}
 } g_gl_property_resetter_; // class ResetGlProperties
 
 Game g_breakout_{ g_gl_property_resetter_, kScreenWidth, kScreenHeight };
 
 int main(int argc, char *argv[])
 {
+	// offline level conversion: OpenGL2dEx --compile-level <in.lvl> <out.blvl>
+	if (argc == 4 && std::strcmp(argv[1], "--compile-level") == 0)
+	{
+		const auto compiled = LevelFormat::compile(argv[2], argv[3]);
+		std::cout << (compiled ? "Compiled " : "Failed to compile ") << argv[2] << std::endl;
+		return compiled ? 0 : -1;
+	}
+
+	// profiling: OpenGL2dEx --bench-level-load
+	if (has_option(argc, argv, "--bench-level-load"))
+	{
+		return Benchmarks::level_load() ? 0 : -1;
+	}
+
+	// OpenGL2dEx --check-collision: exactness check & benchmark of the SIMD kernels
+	if (has_option(argc, argv, "--check-collision"))
+	{
+		return Benchmarks::collision_kernels() ? 0 : -1;
+	}
+
+	// profiling: OpenGL2dEx --bench-ball-contacts
+	if (has_option(argc, argv, "--bench-ball-contacts"))
+	{
+		const auto passed = Benchmarks::ball_contacts();
+		WorkerPool::shutdown();
+		return passed ? 0 : -1;
+	}
+
+	// profiling: OpenGL2dEx --bench-entities
+	if (has_option(argc, argv, "--bench-entities"))
+	{
+		return Benchmarks::entity_layout() ? 0 : -1;
+	}
+
+	// profiling: OpenGL2dEx --bench-log-push
+	if (has_option(argc, argv, "--bench-log-push"))
+	{
+		return Benchmarks::log_push_latency() ? 0 : -1;
+	}
+
+	// profiling: OpenGL2dEx --bench-menu-dispatch
+	if (has_option(argc, argv, "--bench-menu-dispatch"))
+	{
+		return Benchmarks::menu_dispatch() ? 0 : -1;
+	}
+
+	// profiling: OpenGL2dEx --stress-audio, w/ --audio-out <out.wav> to record the mix
+	if (has_option(argc, argv, "--stress-audio"))
+	{
+		const auto audio_out = option_value(argc, argv, "--audio-out");
+		IAudioSink *sink = nullptr;
+		if (audio_out)
+		{
+			sink = new WavFileAudioSink{ audio_out };
+		}
+		else
+		{
+			sink = new NullAudioSink{};
+		}
+		return Benchmarks::audio_stress(sink) ? 0 : -1;
+	}
+
+	// stress/showcase mode: OpenGL2dEx --balls <extra ball count>
+	if (const auto extra_balls = option_value(argc, argv, "--balls"))
+	{
+		SettingsManager::set_extra_balls(std::strtoul(extra_balls, nullptr, 10));
+	}
+
+	// headless audio: OpenGL2dEx --no-audio, or OpenGL2dEx --audio-out <out.wav> to record it
+	// (recording wins if both are given)
+	if (const auto audio_out = option_value(argc, argv, "--audio-out"))
+	{
+		AudioManager::set_backend(new MixerAudioBackend{ new WavFileAudioSink{ audio_out } });
+	}
+	else if (has_option(argc, argv, "--no-audio"))
+	{
+		AudioManager::set_backend(new MixerAudioBackend{ new NullAudioSink{} });
+	}
+
+	// OpenGL2dEx --dynamic-resolution, --low-latency-input and/or --measure-latency
+	if (has_option(argc, argv, "--dynamic-resolution"))
+	{
+		SettingsManager::set_dynamic_resolution(true);
+	}
+	if (has_option(argc, argv, "--low-latency-input"))
+	{
+		SettingsManager::set_low_latency_input(true);
+	}
+	if (has_option(argc, argv, "--measure-latency"))
+	{
+		LatencyProbe::set_enabled(true);
+	}
+
 	glfwInit();
 	// TODO(sasiala): debug callback requires >= 4.3
 #ifdef UTIL_GL_DEBUG
@@ -100,13 +215,32 @@ int main(int argc, char *argv[])
 	glEnable(GL_BLEND);
 	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
+	// profiling: OpenGL2dEx --bench-resize
+	if (has_option(argc, argv, "--bench-resize"))
+	{
+		const auto passed = Benchmarks::render_target_resize(g_gl_property_resetter_);
+		glfwTerminate();
+		return passed ? 0 : -1;
+	}
+
 	// initialize game
 	g_breakout_.initialize();
+	ShaderCache::log_stats();
+
+	// the framebuffer may not match the window size (e.g. on retina displays)
+	int framebuffer_width, framebuffer_height;
+	glfwGetFramebufferSize(window, &framebuffer_width, &framebuffer_height);
+	framebuffer_size_callback(window, framebuffer_width, framebuffer_height);
 
 	// deltaTime variables
 	auto delta_time = 0.0f;
 	auto last_frame = 0.0f;
 
+	// once warmed up, a frame shouldn't allocate; frames that load a level or
+	// open a menu are the expected exceptions (see AllocationCounter::expect_allocations)
+	constexpr unsigned int kAllocationWarmUpFrames{ 120 };
+	auto frame_count = 0u;
+
 	while (!glfwWindowShouldClose(window))
 	{
 		// calculate delta time
@@ -115,24 +249,57 @@ int main(int argc, char *argv[])
 		last_frame = static_cast<float>(current_frame);
 		glfwPollEvents();
 
+		const auto frame_start_allocations = AllocationCounter::count_on_this_thread();
+
 		// manage user input
 		g_breakout_.process_input(delta_time);
 
 		// update game state
 		g_breakout_.update(delta_time);
 
+		if (SettingsManager::low_latency_input())
+		{
+			// pick up input that arrived during the update
+			glfwPollEvents();
+			g_breakout_.late_latch_input(static_cast<float>(glfwGetTime() - current_frame));
+		}
+
 		// render
 		glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
 		glClear(GL_COLOR_BUFFER_BIT);
 		g_breakout_.render();
 
+		if (LatencyProbe::begin_frame())
+		{
+			// the test pattern replaces the frame
+			glClearColor(1.0f, 1.0f, 1.0f, 1.0f);
+			glClear(GL_COLOR_BUFFER_BIT);
+		}
+		LatencyProbe::frame_submitted(glfwGetTime());
+
+		if (AllocationCounter::enabled())
+		{
+			const auto frame_allocations = AllocationCounter::count_on_this_thread() - frame_start_allocations;
+			const auto expected = AllocationCounter::take_expected_allocations();
+			++frame_count;
+			ASSERT(frame_count <= kAllocationWarmUpFrames || expected || frame_allocations == 0,
+				"Frame " << frame_count << " made " << frame_allocations << " heap allocations");
+		}
+
 		glfwSwapBuffers(window);
+		if (LatencyProbe::enabled())
+		{
+			glFinish();
+			LatencyProbe::frame_presented(glfwGetTime());
+		}
 
 		util::check_for_gl_errors();
 	}
 
 	// delete all resources as loaded using manager
 	ResourceManager::clear();
+	AudioManager::shutdown();
+	WorkerPool::shutdown();
 
 	glfwTerminate();
 	return 0;
@@ -144,15 +311,14 @@ void key_callback(GLFWwindow *window, int key, int scan_code, int action, int mo
 	{
 		glfwSetWindowShouldClose(window, true);
 	}
-	if (key >= 0 && key < 1024)
+	// repeats don't change what's held
+	if (key >= 0 && action != GLFW_REPEAT)
 	{
+		const auto time = glfwGetTime();
+		g_breakout_.queue_key_event({ static_cast<KeyId>(key), action == GLFW_PRESS, time });
 		if (action == GLFW_PRESS)
 		{
-			g_breakout_.set_key(key, true);
-		}
-		else if (action == GLFW_RELEASE)
-		{
-			g_breakout_.set_key(key, false);
+			LatencyProbe::record_key_press(time);
 		}
 	}
 }
@@ -163,4 +329,34 @@ void framebuffer_size_callback(GLFWwindow *window, int width, int height)
 	// note that width and height will be significantly larger than
 	// expected on retina displays
 	glViewport(0, 0, width, height);
+
+	// a minimized window reports a 0x0 framebuffer; keep the existing targets
+	if (width > 0 && height > 0)
+	{
+		g_breakout_.resize_framebuffer(static_cast<Game::Dimension>(width), static_cast<Game::Dimension>(height));
+	}
+}
+
+bool has_option(int argc, char *argv[], const char *option)
+{
+	for (int arg = 1; arg < argc; ++arg)
+	{
+		if (std::strcmp(argv[arg], option) == 0)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+const char *option_value(int argc, char *argv[], const char *option)
+{
+	for (int arg = 1; arg + 1 < argc; ++arg)
+	{
+		if (std::strcmp(argv[arg], option) == 0)
+		{
+			return argv[arg + 1];
+		}
+	}
+	return nullptr;
 }
\ No newline at end of file
@@ -0,0 +1,26 @@
+#version 330 core
+in vec2 io_tex_coords_;
+out vec4 io_color_;
+
+uniform sampler2D u_scene_;
+// one texel along the blur axis, e.g. (1/width, 0) for the horizontal pass
+uniform vec2      u_texel_step_;
+// last texel center inside the rendered region; keeps the kernel from reading past it
+uniform vec2      u_uv_max_;
+
+// the original shake kernel, (1 2 1) / 4 per axis, folded into 2 fetches: a linear
+// fetch half a texel off-center weights the center & its neighbour 1/2 each, so
+// averaging the fetches on either side gives 1/4, 1/2, 1/4
+const float kHalfTexel = 0.5;
+
+vec3 fetch(vec2 uv)
+{
+	return texture(u_scene_, clamp(uv, vec2(0.0), u_uv_max_)).rgb;
+}
+
+void main()
+{
+	vec2 offset = u_texel_step_ * kHalfTexel;
+	vec3 color = 0.5 * (fetch(io_tex_coords_ + offset) + fetch(io_tex_coords_ - offset));
+	io_color_ = vec4(color, 1.0);
+}
\ No newline at end of file
@@ -0,0 +1,30 @@
+#version 330 core
+in vec2 io_tex_coords_;
+out vec4 io_color_;
+
+uniform sampler2D u_scene_;
+uniform vec2      u_texel_size_;
+// last texel center inside the rendered region; keeps the kernel from reading past it
+uniform vec2      u_uv_max_;
+
+// 3x3 edge kernel (-1 everywhere, 8 in the center) == 9 * center - (3x3 box sum).
+// A linear fetch 2/3 of a texel off-center weights its texels 1/3 & 2/3, so four
+// diagonal fetches at (+/-2/3, +/-2/3) cover the 3x3 box evenly w/ weight 4/9 each.
+const float kBoxOffset = 2.0 / 3.0;
+const float kBoxScale = 9.0 / 4.0;
+
+vec3 fetch(vec2 uv)
+{
+	return texture(u_scene_, clamp(uv, vec2(0.0), u_uv_max_)).rgb;
+}
+
+void main()
+{
+	vec2 offset = u_texel_size_ * kBoxOffset;
+	vec3 center = fetch(io_tex_coords_);
+	vec3 box = fetch(io_tex_coords_ + vec2(-offset.x,  offset.y))
+			 + fetch(io_tex_coords_ + vec2( offset.x,  offset.y))
+			 + fetch(io_tex_coords_ + vec2(-offset.x, -offset.y))
+			 + fetch(io_tex_coords_ + vec2( offset.x, -offset.y));
+	io_color_ = vec4(9.0 * center - kBoxScale * box, 1.0);
+}
\ No newline at end of file
@@ -0,0 +1,10 @@
+#version 330 core
+in vec2 io_tex_coords_;
+out vec4 io_color_;
+
+uniform sampler2D u_scene_;
+
+void main()
+{
+	io_color_ = vec4(1.0 - texture(u_scene_, io_tex_coords_).rgb, 1.0);
+}
\ No newline at end of file
@@ -0,0 +1,14 @@
+#version 330 core
+layout (location = 0) in vec4 l_vertex_; // <vec2 position, vec2 tex_coords>
+
+out vec2 io_tex_coords_;
+
+// fraction of the render target holding the scene (see dynamic resolution scaling)
+uniform vec2 u_uv_scale_;
+
+// full-screen pass: positions are already in NDC, so no model/projection
+void main()
+{
+	gl_Position = vec4(l_vertex_.xy, 0.0, 1.0);
+	io_tex_coords_ = l_vertex_.zw * u_uv_scale_;
+}
\ No newline at end of file
@@ -1,2 +1,5 @@
 #define STB_IMAGE_IMPLEMENTATION
-#include <stb_image.h>
\ No newline at end of file
+#include <stb_image.h>
+
+// the music decoder includes it header only
+#include <stb_vorbis.c>
\ No newline at end of file
@@ -0,0 +1,89 @@
+#include "allocation_counter.h"
+
+#ifdef UTIL_COUNT_ALLOCATIONS
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+	std::atomic<size_t> allocation_count_{ 0 };
+	thread_local size_t thread_allocation_count_{ 0 };
+
+	void *counted_allocation(const size_t size)
+	{
+		allocation_count_.fetch_add(1, std::memory_order_relaxed);
+		++thread_allocation_count_;
+		// malloc(0) may return null, which operator new mustn't
+		return std::malloc(size > 0 ? size : 1);
+	}
+} // namespace
+
+void *operator new(const size_t size)
+{
+	auto memory = counted_allocation(size);
+	if (!memory)
+	{
+		throw std::bad_alloc{};
+	}
+	return memory;
+}
+
+void *operator new[](const size_t size)
+{
+	return operator new(size);
+}
+
+void *operator new(const size_t size, const std::nothrow_t&) noexcept
+{
+	return counted_allocation(size);
+}
+
+void *operator new[](const size_t size, const std::nothrow_t&) noexcept
+{
+	return counted_allocation(size);
+}
+
+void operator delete(void *memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete[](void *memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete(void *memory, const std::nothrow_t&) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete[](void *memory, const std::nothrow_t&) noexcept
+{
+	std::free(memory);
+}
+#endif
+
+namespace util {
+
+bool AllocationCounter::allocations_expected_{ false };
+
+size_t AllocationCounter::count()
+{
+#ifdef UTIL_COUNT_ALLOCATIONS
+	return allocation_count_.load(std::memory_order_relaxed);
+#else
+	return 0;
+#endif
+}
+
+size_t AllocationCounter::count_on_this_thread()
+{
+#ifdef UTIL_COUNT_ALLOCATIONS
+	return thread_allocation_count_;
+#else
+	return 0;
+#endif
+}
+
+} // namespace util
\ No newline at end of file
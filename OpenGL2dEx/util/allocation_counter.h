@@ -0,0 +1,57 @@
+#ifndef ALLOCATION_COUNTER_H
+#define ALLOCATION_COUNTER_H
+
+#include <cstddef>
+
+namespace util {
+
+// Counts heap allocations made through the global operator new, for checking
+// that per-frame paths don't allocate.  Counting replaces the global operator
+// new, so it's only compiled in w/ UTIL_COUNT_ALLOCATIONS (the AllocationCheck
+// build configuration); otherwise the counts are always 0.  Allocations made by
+// C libraries (GLFW, the GL driver, etc.) don't go through operator new & aren't
+// counted
+class AllocationCounter {
+public:
+	static constexpr bool enabled()
+	{
+#ifdef UTIL_COUNT_ALLOCATIONS
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	// allocations since startup, from every thread
+	static size_t count();
+
+	// allocations since startup made by the calling thread, so a frame isn't
+	// charged for what the audio or logging threads allocate meanwhile
+	static size_t count_on_this_thread();
+
+	// marks the current frame as one that's expected to allocate (e.g. it loads a
+	// level or opens a menu), so the per-frame check skips it
+	static void expect_allocations()
+	{
+		allocations_expected_ = true;
+	}
+
+	// whether expect_allocations() was called since the last call
+	static bool take_expected_allocations()
+	{
+		const auto expected = allocations_expected_;
+		allocations_expected_ = false;
+		return expected;
+	}
+
+private:
+	// singleton
+	AllocationCounter()
+	{}
+
+	static bool allocations_expected_;
+}; // class AllocationCounter
+
+} // namespace util
+
+#endif // ALLOCATION_COUNTER_H
\ No newline at end of file
@@ -3,6 +3,9 @@
 
 #include "logging.h"
 
+#include <cstring>
+#include <type_traits>
+
 namespace util
 {
 
@@ -22,7 +25,17 @@ namespace util
 	}
 
 
-	template <typename T>
+	// trivially copyable types are copied in bulk; the ranges must not overlap
+	template <typename T, std::enable_if_t<std::is_trivially_copyable<T>::value, bool> = true>
+	void copy_ptr_to_ptr(const T *origin, T *dest, size_t num_to_copy)
+	{
+		if (num_to_copy > 0)
+		{
+			std::memcpy(dest, origin, num_to_copy * sizeof(T));
+		}
+	}
+
+	template <typename T, std::enable_if_t<!std::is_trivially_copyable<T>::value, bool> = true>
 	void copy_ptr_to_ptr(const T *origin, T *dest, size_t num_to_copy)
 	{
 		for (auto i = size_t{ 0 }; i < num_to_copy; ++i)
@@ -0,0 +1,100 @@
+#ifndef AUDIO_BACKEND_H
+#define AUDIO_BACKEND_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace util {
+
+// What AudioManager plays sounds through.  Sounds are loaded once up front &
+// then played by id, so playing one never touches the file system
+class IAudioBackend {
+public:
+	using SoundId = uint32_t;
+	using Volume = float; // 0 (silent) to 1 (full)
+	using Priority = uint8_t;
+
+	struct SoundSettings {
+		size_t   max_voices_; // copies playing at once; past this, its oldest copy is restarted
+		Priority priority_; // when every voice is busy, lower priority sounds are cut off first
+	};
+
+	virtual ~IAudioBackend()
+	{
+	}
+
+	// a sound that fails to load still gets an id; it just plays silence
+	SoundId load_sound(const char *path, const SoundSettings &settings)
+	{
+		return load_sound_impl(path, settings);
+	}
+
+	// cheap & non-blocking, so it's safe to call from the game loop
+	void play_sound(const SoundId sound_id)
+	{
+		play_sound_impl(sound_id);
+	}
+
+	void play_music(const char *path, const bool loop)
+	{
+		play_music_impl(path, loop);
+	}
+
+	void set_volume(const Volume volume)
+	{
+		set_volume_impl(volume);
+	}
+
+	Volume volume() const
+	{
+		return volume_impl();
+	}
+
+private:
+	virtual SoundId load_sound_impl(const char *path, const SoundSettings &settings) = 0;
+	virtual void play_sound_impl(SoundId sound_id) = 0;
+	virtual void play_music_impl(const char *path, bool loop) = 0;
+	virtual void set_volume_impl(Volume volume) = 0;
+	virtual Volume volume_impl() const = 0;
+}; // class IAudioBackend
+
+// Plays nothing & starts no threads; for when there's no output device
+class NullAudioBackend : public IAudioBackend {
+public:
+	NullAudioBackend()
+		: sound_count_{ 0 }
+		, volume_{ 1.0f }
+	{
+	}
+
+private:
+	SoundId load_sound_impl(const char* /*path*/, const SoundSettings& /*settings*/) override
+	{
+		return sound_count_++;
+	}
+
+	void play_sound_impl(SoundId /*sound_id*/) override
+	{
+	}
+
+	void play_music_impl(const char* /*path*/, bool /*loop*/) override
+	{
+	}
+
+	void set_volume_impl(const Volume volume) override
+	{
+		volume_ = volume;
+	}
+
+	Volume volume_impl() const override
+	{
+		return volume_;
+	}
+
+	SoundId sound_count_;
+	Volume  volume_;
+}; // class NullAudioBackend
+
+} // namespace util
+
+#endif // AUDIO_BACKEND_H
\ No newline at end of file
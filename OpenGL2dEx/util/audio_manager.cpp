@@ -1,32 +1,98 @@
 #include "audio_manager.h"
 
+#include "irrklang_audio_backend.h"
 #include "logging.h"
+#include "mixer_audio_backend.h"
 
-#include <irrKlang.h>
-#include <string>
+namespace util {
 
-namespace {
-	// TODO(sasiala): deal with the .dll's and all for irrklang
-	irrklang::ISoundEngine *sound_engine = irrklang::createIrrKlangDevice();
-} // namespace
+constexpr std::chrono::milliseconds AudioManager::kCoalesceWindow;
 
-namespace util {
+const char * const AudioManager::kMusicPaths[kNumGameStates]{
+	"audio/menu.wav",
+	"audio/breakout.wav",
+};
+
+// power-ups are rare & worth hearing, so they outrank the constant brick hits
+const AudioManager::SoundInfo AudioManager::kSounds[kNumSounds]{
+	{ "audio/bleep.wav",   { 4, 1 } },
+	{ "audio/solid.wav",   { 4, 1 } },
+	{ "audio/powerup.wav", { 2, 3 } },
+	{ "audio/bleep.wav",   { 2, 2 } },
+};
+IAudioBackend                   *AudioManager::backend_{ nullptr };
+AudioManager::GameState          AudioManager::music_state_{ GameState::kUnknown };
+IAudioBackend::SoundId           AudioManager::sound_ids_[kNumSounds]{};
+AudioManager::Clock::time_point  AudioManager::last_played_[kNumSounds]{};
+
+void AudioManager::set_backend(IAudioBackend *backend)
+{
+	ASSERT(backend, "No audio backend");
+
+	delete backend_;
+	backend_ = backend;
+	for (size_t sound = 0; sound < kNumSounds; ++sound)
+	{
+		sound_ids_[sound] = backend_->load_sound(kSounds[sound].path_, kSounds[sound].settings_);
+	}
+}
+
+void AudioManager::shutdown()
+{
+	delete backend_;
+	backend_ = nullptr;
+	music_state_ = GameState::kUnknown;
+}
+
+IAudioBackend &AudioManager::backend()
+{
+	if (!backend_)
+	{
+#ifdef _WIN32
+		set_backend(new IrrKlangAudioBackend{});
+#else
+		// there's no output device sink outside Windows yet; running the mixer
+		// into nothing would only cost wakeups, so audio is off unless asked for
+		// (--no-audio or --audio-out run the mixer w/o a device)
+		set_backend(new NullAudioBackend{});
+#endif
+	}
+	return *backend_;
+}
+
+void AudioManager::play(const Sound sound)
+{
+	ASSERT(sound < Sound::kNumSounds, "Invalid sound");
+
+	const auto index = static_cast<size_t>(sound);
+	const auto now = Clock::now();
+	if (now - last_played_[index] < kCoalesceWindow)
+	{
+		return;
+	}
+	last_played_[index] = now;
+	backend().play_sound(sound_ids_[index]);
+}
 
 void AudioManager::set_volume(const VolumePercentage volume)
 {
-	sound_engine->setSoundVolume(volume / 100.0f);
+	backend().set_volume(volume / 100.0f);
 }
 
 AudioManager::VolumePercentage AudioManager::volume()
 {
-	return sound_engine->getSoundVolume() * 100.0f;
+	return backend().volume() * 100.0f;
 }
 
 void AudioManager::play_background_music(const GameState state, const bool loop)
 {
-	ASSERT(GameState::kActive == state, "Invalid game state");
-	LOG("Volume: " + std::to_string(sound_engine->getSoundVolume()));
-	sound_engine->play2D(kActiveGameBgMusicPath, loop);
+	ASSERT(state < GameState::kNumStates, "Invalid game state");
+	if (music_state_ == state)
+	{
+		return;
+	}
+	music_state_ = state;
+	backend().play_music(kMusicPaths[static_cast<size_t>(state)], loop);
 }
 
 void AudioManager::play_ball_brick_collision_sound(const BallBrickCollisionType collision_type)
@@ -35,13 +101,13 @@ void AudioManager::play_ball_brick_collision_sound(const BallBrickCollisionType
 	switch (collision_type)
 	{
 	case util::AudioManager::BallBrickCollisionType::kNormal:
-		sound_engine->play2D(kNormalBallBrickCollisionAudioPath, false);
+		play(Sound::kNormalBallBrickCollision);
 		break;
 	case util::AudioManager::BallBrickCollisionType::kSolid:
-		sound_engine->play2D(kSolidBallBrickCollisionAudioPath, false);
+		play(Sound::kSolidBallBrickCollision);
 		break;
 	case util::AudioManager::BallBrickCollisionType::kPowerUp:
-		sound_engine->play2D(kPowerUpBallBrickCollisionAudioPath, false);
+		play(Sound::kPowerUpBallBrickCollision);
 		break;
 	default:
 		ASSERT(false, "Invalid ball-brick collision type");
@@ -51,7 +117,7 @@ void AudioManager::play_ball_brick_collision_sound(const BallBrickCollisionType
 
 void AudioManager::play_ball_paddle_collision_sound()
 {
-	sound_engine->play2D(kBallPaddleCollisionAudioPath, false);
+	play(Sound::kBallPaddleCollision);
 }
 
 } // namespace util
\ No newline at end of file
@@ -1,12 +1,25 @@
 #ifndef AUDIO_MANAGER_H
 #define AUDIO_MANAGER_H
 
+#include "audio_backend.h"
+
+#include <chrono>
+#include <cstddef>
+
 namespace util {
 
 class AudioManager {
 public:
 	using VolumePercentage = float;
 
+	// takes ownership of backend (& deletes the current one); the game's sounds
+	// are loaded into it right away.  W/o a call, the platform's default backend
+	// is used: irrKlang on Windows, otherwise none (NullAudioBackend), as
+	// there's no output device to mix for
+	static void set_backend(IAudioBackend *backend);
+	// deletes the backend; call before exiting
+	static void shutdown();
+
 	// accepts volume as a percentage, e.g. volume = 98.0f means "98.0%"
 	static void set_volume(VolumePercentage volume);
 	static VolumePercentage volume();
@@ -17,6 +30,8 @@ public:
 		kNumStates,
 		kUnknown,
 	};
+	// crossfades to the state's track; asking for the state that's already
+	// playing does nothing
 	static void play_background_music(GameState state, bool loop);
 
 	enum class BallBrickCollisionType {
@@ -35,13 +50,40 @@ private:
 	{
 	}
 
-	static constexpr const char * kActiveGameBgMusicPath = "audio/breakout.mp3";
-	static constexpr const char * kNormalBallBrickCollisionAudioPath = "audio/bleep.mp3";
-	static constexpr const char * kSolidBallBrickCollisionAudioPath = "audio/solid.wav";
-	static constexpr const char * kPowerUpBallBrickCollisionAudioPath = "audio/powerup.wav";
-	static constexpr const char * kBallPaddleCollisionAudioPath = "audio/bleep.wav";
+	static IAudioBackend &backend();
+
+	// every sound effect, loaded once into the backend
+	enum class Sound {
+		kNormalBallBrickCollision,
+		kSolidBallBrickCollision,
+		kPowerUpBallBrickCollision,
+		kBallPaddleCollision,
+		kNumSounds,
+	};
+	static constexpr size_t kNumSounds{ static_cast<size_t>(Sound::kNumSounds) };
+	// repeats of a sound within kCoalesceWindow of the last one played are
+	// dropped; a storm of hits in one frame sounds the same as a single hit
+	static void play(Sound sound);
+
+	using Clock = std::chrono::steady_clock;
+	static constexpr std::chrono::milliseconds kCoalesceWindow{ 30 };
+
+	struct SoundInfo {
+		const char                  *path_; // all .wav, so any backend can decode them
+		IAudioBackend::SoundSettings settings_;
+	};
+
+	static constexpr size_t kNumGameStates{ static_cast<size_t>(GameState::kNumStates) };
+	// .wav, like the sounds, so both backends can stream them
+	static const char * const kMusicPaths[kNumGameStates]; // in GameState order
+	static const SoundInfo kSounds[kNumSounds]; // in Sound order
+
+	static IAudioBackend         *backend_;
+	static GameState              music_state_; // kUnknown before any music's played
+	static IAudioBackend::SoundId sound_ids_[kNumSounds];
+	static Clock::time_point      last_played_[kNumSounds];
 };
 
 } // namespace util
 
-#endif // !AUDIO_MANAGER_H
+#endif // !AUDIO_MANAGER_H
\ No newline at end of file
@@ -0,0 +1,79 @@
+#include "audio_sink.h"
+
+#include "logging.h"
+#include "wav_decoder.h"
+
+namespace util {
+
+namespace {
+	constexpr uint32_t kWavHeaderSize{ 44 };
+
+	void write_u16(std::ofstream &file, const uint16_t value)
+	{
+		const char bytes[] = { static_cast<char>(value & 0xff), static_cast<char>(value >> 8) };
+		file.write(bytes, sizeof(bytes));
+	}
+
+	void write_u32(std::ofstream &file, const uint32_t value)
+	{
+		write_u16(file, static_cast<uint16_t>(value & 0xffff));
+		write_u16(file, static_cast<uint16_t>(value >> 16));
+	}
+
+	void write_header(std::ofstream &file, const uint32_t data_size)
+	{
+		static constexpr uint16_t kBitsPerSample{ 16 };
+		static constexpr uint16_t kBlockAlign{ kPcmChannels * kBitsPerSample / 8 };
+
+		file.write("RIFF", 4);
+		write_u32(file, kWavHeaderSize - 8 + data_size);
+		file.write("WAVEfmt ", 8);
+		write_u32(file, 16); // format chunk size
+		write_u16(file, 1); // PCM
+		write_u16(file, static_cast<uint16_t>(kPcmChannels));
+		write_u32(file, kPcmSampleRate);
+		write_u32(file, kPcmSampleRate * kBlockAlign);
+		write_u16(file, kBlockAlign);
+		write_u16(file, kBitsPerSample);
+		file.write("data", 4);
+		write_u32(file, data_size);
+	}
+} // namespace
+
+WavFileAudioSink::WavFileAudioSink(const char *path)
+	: file_{ path, std::ios::binary | std::ios::trunc }
+	, data_size_{ 0 }
+{
+	if (!file_)
+	{
+		LOG_ERROR("Failed to open audio output file: " << path);
+		return;
+	}
+
+	// sizes are filled in once they're known
+	write_header(file_, 0);
+}
+
+WavFileAudioSink::~WavFileAudioSink()
+{
+	if (file_)
+	{
+		file_.seekp(0);
+		write_header(file_, data_size_);
+	}
+}
+
+void WavFileAudioSink::write_impl(const int16_t *samples, const size_t frames)
+{
+	if (!file_)
+	{
+		return;
+	}
+
+	// .wav samples are little-endian, as is every platform this runs on
+	const auto size = static_cast<uint32_t>(frames * kPcmChannels * sizeof(int16_t));
+	file_.write(reinterpret_cast<const char*>(samples), size);
+	data_size_ += size;
+}
+
+} // namespace util
\ No newline at end of file
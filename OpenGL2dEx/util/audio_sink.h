@@ -0,0 +1,54 @@
+#ifndef AUDIO_SINK_H
+#define AUDIO_SINK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+
+namespace util {
+
+// Where the mixer sends each mixed block (interleaved 16-bit stereo at
+// kPcmSampleRate).  Called from the mixer's thread only
+class IAudioSink {
+public:
+	virtual ~IAudioSink()
+	{
+	}
+
+	void write(const int16_t *samples, const size_t frames)
+	{
+		write_impl(samples, frames);
+	}
+
+private:
+	virtual void write_impl(const int16_t *samples, size_t frames) = 0;
+}; // class IAudioSink
+
+// Discards everything; for headless runs that only need the mixer to run
+class NullAudioSink : public IAudioSink {
+private:
+	void write_impl(const int16_t* /*samples*/, size_t /*frames*/) override
+	{
+	}
+}; // class NullAudioSink
+
+// Records everything to a .wav file, e.g. to check what a headless run played
+class WavFileAudioSink : public IAudioSink {
+public:
+	explicit WavFileAudioSink(const char *path);
+	// fills in the sizes in the header
+	~WavFileAudioSink() override;
+
+	WavFileAudioSink(const WavFileAudioSink&) = delete;
+	WavFileAudioSink &operator=(const WavFileAudioSink&) = delete;
+
+private:
+	void write_impl(const int16_t *samples, size_t frames) override;
+
+	std::ofstream file_;
+	uint32_t      data_size_; // bytes of samples written so far
+}; // class WavFileAudioSink
+
+} // namespace util
+
+#endif // AUDIO_SINK_H
\ No newline at end of file
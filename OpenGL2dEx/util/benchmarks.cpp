@@ -0,0 +1,845 @@
+#include "benchmarks.h"
+
+#include "audio_manager.h"
+#include "audio_sink.h"
+#include "collision.h"
+#include "element_list.h"
+#include "entity_registry.h"
+#include "entity_systems.h"
+#include "game_level.h"
+#include "game_viewport.h"
+#include "label.h"
+#include "level_format.h"
+#include "level_template.h"
+#include "logger.h"
+#include "mixer_audio_backend.h"
+#include "parallel_for.h"
+#include "post_processor.h"
+#include "reset_gl_properties.h"
+#include "shader.h"
+#include "wav_decoder.h"
+
+#include <glad/glad.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <new>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace util {
+
+namespace {
+	using Clock = std::chrono::steady_clock;
+
+	double to_microseconds(const Clock::duration duration)
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count() / 1000.0;
+	}
+
+	template <typename Function>
+	double time_microseconds(Function fn)
+	{
+		const auto start = Clock::now();
+		fn();
+		return to_microseconds(Clock::now() - start);
+	}
+
+	const char *kernel_name(const CollisionKernel kernel)
+	{
+		switch (kernel)
+		{
+		case CollisionKernel::kScalar: return "scalar";
+		case CollisionKernel::kSse2: return "SSE2";
+		case CollisionKernel::kAvx: return "AVX";
+		default: return "unknown";
+		}
+	}
+
+	// forwards to another sink (& owns it), counting the frames the mixer's produced
+	class CountingAudioSink : public IAudioSink {
+	public:
+		explicit CountingAudioSink(IAudioSink *sink)
+			: sink_{ sink }
+			, frames_{ 0 }
+		{
+		}
+
+		~CountingAudioSink() override
+		{
+			delete sink_;
+		}
+
+		size_t frames() const
+		{
+			return frames_.load(std::memory_order_acquire);
+		}
+
+	private:
+		void write_impl(const int16_t *samples, const size_t frames) override
+		{
+			sink_->write(samples, frames);
+			frames_.fetch_add(frames, std::memory_order_release);
+		}
+
+		IAudioSink          *sink_;
+		std::atomic<size_t> frames_;
+	}; // class CountingAudioSink
+
+	// parallel_for as it was before the WorkerPool: threads created & joined every call
+	template <typename Function>
+	void parallel_for_fresh_threads(const size_t count, const size_t min_chunk, Function function)
+	{
+		const auto chunks = std::min(WorkerPool::thread_count(), count / std::max<size_t>(min_chunk, 1));
+		if (chunks <= 1)
+		{
+			function(size_t{ 0 }, count);
+			return;
+		}
+
+		const auto chunk_size = (count + chunks - 1) / chunks;
+		std::thread workers[WorkerPool::kMaxThreads];
+		for (size_t chunk = 1; chunk < chunks; ++chunk)
+		{
+			const auto begin = chunk * chunk_size;
+			workers[chunk] = std::thread{ function, begin, std::min(count, begin + chunk_size) };
+		}
+		function(size_t{ 0 }, std::min(count, chunk_size));
+		for (size_t chunk = 1; chunk < chunks; ++chunk)
+		{
+			workers[chunk].join();
+		}
+	}
+
+	// the layout the EntityRegistry replaced: a fat object per ball (GameObject's
+	// fields, a Texture2D's worth of render state & BallObject's flags), reached
+	// through a base pointer when objects of different types are walked together
+	class LegacyObject {
+	public:
+		LegacyObject(const glm::vec2 &position, const glm::vec2 &size, const glm::vec2 &velocity)
+			: position_{ position }
+			, size_{ size }
+			, velocity_{ velocity }
+			, color_{ 1.0f }
+			, rotation_{ 0.0f }
+			, is_solid_{ false }
+			, destroyed_{ false }
+			, texture_{}
+		{
+		}
+
+		virtual ~LegacyObject()
+		{
+		}
+
+		virtual void update(float dt, float width) = 0;
+
+	protected:
+		glm::vec2    position_;
+		glm::vec2    size_;
+		glm::vec2    velocity_;
+		glm::vec3    color_;
+		float        rotation_;
+		bool         is_solid_;
+		bool         destroyed_;
+		unsigned int texture_[9]; // id, size, formats, wrap & filter modes
+	}; // class LegacyObject
+
+	class LegacyBall final : public LegacyObject {
+	public:
+		LegacyBall(const glm::vec2 &position, const float radius, const glm::vec2 &velocity)
+			: LegacyObject{ position, glm::vec2{ radius * 2.0f }, velocity }
+			, radius_{ radius }
+			, stuck_{ false }
+			, sticky_{ false }
+			, pass_through_{ false }
+		{
+		}
+
+		// BallObject::move
+		void update(const float dt, const float width) override
+		{
+			if (stuck_)
+			{
+				return;
+			}
+
+			position_ += velocity_ * dt;
+			if (position_.x <= 0.0f)
+			{
+				velocity_.x = -velocity_.x;
+				position_.x = 0.0f;
+			}
+			else if (position_.x + size_.x >= width)
+			{
+				velocity_.x = -velocity_.x;
+				position_.x = width - size_.x;
+			}
+
+			if (position_.y <= 0.0f)
+			{
+				velocity_.y = -velocity_.y;
+				position_.y = 0.0f;
+			}
+		}
+
+		float y() const
+		{
+			return position_.y;
+		}
+
+	private:
+		float radius_;
+		bool  stuck_;
+		bool  sticky_;
+		bool  pass_through_;
+	}; // class LegacyBall
+
+	// how ElementUnion dispatched before it visited the held type: a producer
+	// (one per type) is called virtually to turn the union's storage into an
+	// Element pointer, which is then called through the vtable
+	class LegacyElementPointerProducer {
+	public:
+		virtual ~LegacyElementPointerProducer()
+		{
+		}
+
+		virtual Element *make_element_pointer(unsigned char *data) const = 0;
+		virtual const Element *make_const_element_pointer(const unsigned char *data) const = 0;
+	}; // class LegacyElementPointerProducer
+
+	template <typename ElementType>
+	class LegacyElementPointerProducerImpl final : public LegacyElementPointerProducer {
+	public:
+		Element *make_element_pointer(unsigned char *data) const override
+		{
+			return reinterpret_cast<ElementType*>(data);
+		}
+
+		const Element *make_const_element_pointer(const unsigned char *data) const override
+		{
+			return reinterpret_cast<const ElementType*>(data);
+		}
+	}; // class LegacyElementPointerProducerImpl
+
+	template <typename ElementType>
+	class LegacyElementUnion final : public Element {
+	public:
+		LegacyElementUnion()
+			: Element{ false }
+			, producer_{ nullptr }
+		{
+			static const LegacyElementPointerProducerImpl<ElementType> producer{};
+			new(data_) ElementType{};
+			producer_ = &producer;
+		}
+
+		~LegacyElementUnion() override
+		{
+			element_ptr()->~Element();
+		}
+
+		LegacyElementUnion(const LegacyElementUnion&) = delete;
+		LegacyElementUnion &operator=(const LegacyElementUnion&) = delete;
+
+	private:
+		Element *element_ptr()
+		{
+			return producer_ ? producer_->make_element_pointer(data_) : nullptr;
+		}
+
+		const Element *element_ptr() const
+		{
+			return producer_ ? producer_->make_const_element_pointer(data_) : nullptr;
+		}
+
+		void initialize_impl(const glm::mat4 &projection) override
+		{
+			element_ptr()->initialize(projection);
+		}
+		void update_impl(const Time dt) override
+		{
+			element_ptr()->update(dt);
+		}
+		void activate_impl() override
+		{
+			element_ptr()->activate();
+		}
+		void deactivate_impl() override
+		{
+			element_ptr()->deactivate();
+		}
+		void render_impl(const Optional<SpriteRenderer*> parent_sprite_renderer) override
+		{
+			element_ptr()->render(parent_sprite_renderer);
+		}
+		void process_input_impl(const InputState &input, const Time dt) override
+		{
+			element_ptr()->process_input(input, dt);
+		}
+		bool is_dirty_impl() const override
+		{
+			return element_ptr()->is_dirty();
+		}
+		void clear_dirty_impl() override
+		{
+			element_ptr()->clear_dirty();
+		}
+
+		alignas(ElementType) unsigned char   data_[sizeof(ElementType)];
+		const LegacyElementPointerProducer *producer_;
+	}; // class LegacyElementUnion
+
+	// wall-clock time of fn, including the GPU work it queued
+	template <typename Function>
+	double time_gl_microseconds(Function fn)
+	{
+		glFinish();
+		const auto start = Clock::now();
+		fn();
+		glFinish();
+		return to_microseconds(Clock::now() - start);
+	}
+} // namespace
+
+bool Benchmarks::render_target_resize(const IResetGlProperties &gl_property_resetter)
+{
+	constexpr Dimension kWidth{ 800 };
+	constexpr Dimension kHeight{ 600 };
+	// the viewport animation shrinks the scene to half size over about a second
+	constexpr unsigned int kFrames{ 60 };
+
+	const Shader post_processing_shader{ "shaders/effects.vs", "shaders/effects.fs", {} };
+	const Shader blur_shader{ "shaders/post_pass.vs", "shaders/post_blur.fs", {} };
+	const Shader edge_shader{ "shaders/post_pass.vs", "shaders/post_edge.fs", {} };
+	const Shader invert_shader{ "shaders/post_pass.vs", "shaders/post_invert.fs", {} };
+	PostProcessor effects{ gl_property_resetter, post_processing_shader, blur_shader, edge_shader,
+		invert_shader, { 0.0f, 0.0f }, kWidth, kHeight, glm::mat4{ 1.0f } };
+
+	// allocate everything up front
+	effects.begin_render();
+	effects.end_render();
+
+	// each frame's resize is timed together w/ the begin_render that uses the new
+	// size (the MSAA storage is reallocated lazily), next to a steady begin_render
+	struct FrameCost {
+		double resized_;
+		double steady_;
+	};
+	const auto measure = [&effects](const bool reallocate) {
+		FrameCost cost{ 0.0, 0.0 };
+		for (unsigned int frame = 1; frame <= kFrames; ++frame)
+		{
+			const Dimension width = kWidth - (kWidth / 2) * frame / kFrames;
+			const Dimension height = kHeight - (kHeight / 2) * frame / kFrames;
+			cost.resized_ += time_gl_microseconds([&]() {
+				if (reallocate)
+				{
+					effects.set_render_size(width, height);
+				}
+				else
+				{
+					effects.set_display_size(width, height);
+				}
+				effects.begin_render();
+			});
+			effects.end_render();
+
+			cost.steady_ += time_gl_microseconds([&]() { effects.begin_render(); });
+			effects.end_render();
+		}
+		cost.resized_ /= kFrames;
+		cost.steady_ /= kFrames;
+		return cost;
+	};
+
+	const auto reallocating = measure(true);
+	effects.set_render_size(kWidth, kHeight);
+	const auto display_only = measure(false);
+
+	std::cout << "Viewport resize cost per animation frame (" << kFrames << " frames, "
+		<< kWidth << "x" << kHeight << " -> " << kWidth / 2 << "x" << kHeight / 2 << ", "
+		<< PostProcessor::msaa_samples() << "x MSAA), begin_render w/ resize vs w/o:\n"
+		<< "  set_render_size:  " << reallocating.resized_ << "us vs " << reallocating.steady_ << "us\n"
+		<< "  set_display_size: " << display_only.resized_ << "us vs " << display_only.steady_ << "us" << std::endl;
+	return true;
+}
+
+
+bool Benchmarks::level_load()
+{
+	constexpr uint32_t kLevelSize{ 1000 };
+	constexpr unsigned int kLoads{ 5 };
+	const char *kTextPath = "benchmark_level.lvl";
+	const char *kBinaryPath = "benchmark_level.blvl";
+	const char *kInvalidPath = "benchmark_invalid.blvl";
+
+	{
+		// every tile code, empty cells included
+		std::ofstream text_file{ kTextPath, std::ios::trunc };
+		for (uint32_t y = 0; y < kLevelSize; ++y)
+		{
+			for (uint32_t x = 0; x < kLevelSize; ++x)
+			{
+				text_file << (x + y) % (LevelFormat::kMaxTileCode + 1u) << (x + 1 < kLevelSize ? ' ' : '\n');
+			}
+		}
+	}
+
+	auto passed = LevelFormat::compile(kTextPath, kBinaryPath);
+	if (passed)
+	{
+		// a copy of the binary level w/ its last tile out of range
+		std::ifstream binary_file{ kBinaryPath, std::ios::binary };
+		std::vector<char> binary{ std::istreambuf_iterator<char>{ binary_file }, std::istreambuf_iterator<char>{} };
+		binary.back() = static_cast<char>(LevelFormat::kMaxTileCode + 1);
+		std::ofstream invalid_file{ kInvalidPath, std::ios::binary | std::ios::trunc };
+		invalid_file.write(binary.data(), static_cast<std::streamsize>(binary.size()));
+	}
+
+	LevelTemplate level{};
+	const auto average_load = [&level, &passed](const char *path) {
+		auto total = 0.0;
+		for (unsigned int load = 0; load < kLoads; ++load)
+		{
+			total += time_microseconds([&]() { passed = level.load(path, 800, 300) && passed; });
+		}
+		return total / kLoads / 1000.0;
+	};
+
+	if (passed)
+	{
+		const auto text_load = average_load(kTextPath);
+		const auto binary_load = average_load(kBinaryPath);
+		std::cout << kLevelSize << "x" << kLevelSize << " level load, average of " << kLoads << ":\n"
+			<< "  text:   " << text_load << "ms\n"
+			<< "  binary: " << binary_load << "ms" << std::endl;
+
+		const auto rejected = !level.load(kInvalidPath, 800, 300) && level.brick_count() == 0;
+		std::cout << "Invalid tile code " << (rejected ? "rejected" : "NOT rejected") << std::endl;
+		passed = passed && rejected;
+	}
+
+	std::remove(kTextPath);
+	std::remove(kBinaryPath);
+	std::remove(kInvalidPath);
+	return passed;
+}
+
+bool Benchmarks::collision_kernels()
+{
+	constexpr unsigned int kLayouts{ 20000 };
+	constexpr size_t kMaxBoxes{ 67 }; // odd, so every kernel leaves a scalar tail
+	constexpr size_t kGridSize{ 100 };
+	constexpr unsigned int kTimedCircles{ 20000 };
+
+	const auto best = best_collision_kernel();
+	std::mt19937 random{ 5489u };
+	std::uniform_real_distribution<float> coordinate{ -4.0f, 4.0f };
+	std::uniform_real_distribution<float> extent{ 0.0f, 2.0f };
+	// multiples of 1/8 are exact in binary, so many of these circles touch a box exactly
+	std::uniform_int_distribution<int> eighths{ -32, 32 };
+	std::uniform_int_distribution<size_t> box_count{ 0, kMaxBoxes };
+
+	std::vector<float> x(kMaxBoxes);
+	std::vector<float> y(kMaxBoxes);
+	std::vector<uint8_t> expected(kMaxBoxes);
+	std::vector<uint8_t> hits(kMaxBoxes);
+	auto passed = true;
+	for (unsigned int layout = 0; layout < kLayouts; ++layout)
+	{
+		const auto snapped = (layout % 2) == 0;
+		const auto value = [&](std::uniform_real_distribution<float> &continuous) {
+			return snapped ? eighths(random) / 8.0f : continuous(random);
+		};
+
+		const auto count = box_count(random);
+		for (size_t i = 0; i < count; ++i)
+		{
+			x[i] = value(coordinate);
+			y[i] = value(coordinate);
+		}
+		const glm::vec2 half_extents{ std::abs(value(extent)), std::abs(value(extent)) };
+		const glm::vec2 center{ value(coordinate), value(coordinate) };
+		const auto radius = std::abs(value(extent));
+
+		find_circle_hits_scalar(x.data(), y.data(), count, half_extents, center, radius, expected.data());
+		for (auto kernel = CollisionKernel::kSse2; kernel <= best;
+			kernel = static_cast<CollisionKernel>(static_cast<int>(kernel) + 1))
+		{
+			find_circle_hits(kernel, x.data(), y.data(), count, half_extents, center, radius, hits.data());
+			if (count > 0 && std::memcmp(expected.data(), hits.data(), count) != 0)
+			{
+				std::cout << kernel_name(kernel) << " differs from scalar in layout " << layout << std::endl;
+				passed = false;
+			}
+		}
+	}
+	std::cout << "Collision kernels up to " << kernel_name(best) << " checked against scalar over "
+		<< kLayouts << " layouts: " << (passed ? "identical" : "MISMATCH") << std::endl;
+
+	// a level's worth of bricks on a unit grid
+	constexpr auto kBoxes = kGridSize * kGridSize;
+	x.resize(kBoxes);
+	y.resize(kBoxes);
+	hits.resize(kBoxes);
+	for (size_t i = 0; i < kBoxes; ++i)
+	{
+		x[i] = static_cast<float>(i % kGridSize);
+		y[i] = static_cast<float>(i / kGridSize);
+	}
+	std::uniform_real_distribution<float> position{ 0.0f, static_cast<float>(kGridSize) };
+	std::vector<glm::vec2> centers(kTimedCircles);
+	for (auto &center : centers)
+	{
+		center = { position(random), position(random) };
+	}
+
+	std::cout << kBoxes << " boxes x " << kTimedCircles << " circles:\n";
+	for (auto kernel = CollisionKernel::kScalar; kernel <= best;
+		kernel = static_cast<CollisionKernel>(static_cast<int>(kernel) + 1))
+	{
+		size_t total_hits{ 0 };
+		const auto microseconds = time_microseconds([&]() {
+			for (const auto &center : centers)
+			{
+				find_circle_hits(kernel, x.data(), y.data(), kBoxes, { 0.5f, 0.5f }, center, 0.75f, hits.data());
+				total_hits += hits[kBoxes / 2];
+			}
+		});
+		std::cout << "  " << kernel_name(kernel) << ": " << microseconds * 1000.0 / (static_cast<double>(kBoxes) * kTimedCircles)
+			<< "ns per box (" << total_hits << " center hits)\n";
+	}
+	std::cout.flush();
+	return passed;
+}
+
+bool Benchmarks::ball_contacts()
+{
+	constexpr unsigned int kLevelWidth{ 800 };
+	constexpr unsigned int kLevelHeight{ 300 };
+	constexpr unsigned int kFrames{ 200 };
+	constexpr float kRadius{ 12.5f };
+	constexpr size_t kMaxContacts{ 8 };
+	const size_t kBallCounts[] = { 1, 100, 10000 };
+
+	GameLevel level{};
+	level.load("levels/one.lvl", kLevelWidth, kLevelHeight);
+	if (level.brick_count() == 0)
+	{
+		std::cout << "Failed to load levels/one.lvl" << std::endl;
+		return false;
+	}
+
+	std::mt19937 random{ 5489u };
+	std::uniform_real_distribution<float> x{ 0.0f, static_cast<float>(kLevelWidth) };
+	std::uniform_real_distribution<float> y{ 0.0f, static_cast<float>(kLevelHeight) };
+	std::vector<glm::vec2> centers(kBallCounts[2]);
+	for (auto &center : centers)
+	{
+		center = { x(random), y(random) };
+	}
+	std::vector<GameLevel::BrickIndex> contacts(kBallCounts[2] * kMaxContacts);
+	std::vector<size_t> contact_counts(kBallCounts[2]);
+
+	const auto find_contacts = [&](const size_t first_ball, const size_t end_ball) {
+		for (auto ball = first_ball; ball < end_ball; ++ball)
+		{
+			contact_counts[ball] = level.find_bricks_near(centers[ball], kRadius, &contacts[ball * kMaxContacts], kMaxContacts);
+		}
+	};
+
+	std::cout << "Ball contact search per frame (" << kFrames << " frames, " << WorkerPool::thread_count()
+		<< " threads, " << GameViewport::kMinBallsPerThread << "+ balls per thread):\n";
+	for (const auto balls : kBallCounts)
+	{
+		const auto inline_time = time_microseconds([&]() {
+			for (unsigned int frame = 0; frame < kFrames; ++frame)
+			{
+				find_contacts(0, balls);
+			}
+		});
+		const auto fresh_threads_time = time_microseconds([&]() {
+			for (unsigned int frame = 0; frame < kFrames; ++frame)
+			{
+				parallel_for_fresh_threads(balls, GameViewport::kMinBallsPerThread, find_contacts);
+			}
+		});
+		const auto pool_time = time_microseconds([&]() {
+			for (unsigned int frame = 0; frame < kFrames; ++frame)
+			{
+				parallel_for(balls, GameViewport::kMinBallsPerThread, find_contacts);
+			}
+		});
+		std::cout << "  " << balls << " balls: inline " << inline_time / kFrames
+			<< "us, fresh threads " << fresh_threads_time / kFrames
+			<< "us, worker pool " << pool_time / kFrames << "us\n";
+	}
+	std::cout.flush();
+	return true;
+}
+
+bool Benchmarks::entity_layout()
+{
+	constexpr float kWidth{ 800.0f };
+	constexpr float kHeight{ 600.0f };
+	constexpr float kRadius{ 12.5f };
+	constexpr float kDt{ 1.0f / 60.0f };
+	constexpr unsigned int kFrames{ 100 };
+	const size_t kBallCounts[] = { 1000, 10000, 100000 };
+
+	auto passed = true;
+	std::cout << "Moving & bouncing balls, per frame (" << kFrames << " frames):\n";
+	for (const auto balls : kBallCounts)
+	{
+		std::mt19937 random{ 5489u };
+		std::uniform_real_distribution<float> x{ 0.0f, kWidth - 2.0f * kRadius };
+		std::uniform_real_distribution<float> y{ 0.0f, kHeight };
+		std::uniform_real_distribution<float> speed{ -500.0f, 500.0f };
+
+		EntityRegistry registry{ balls };
+		std::vector<LegacyBall> ball_pool{};
+		ball_pool.reserve(balls);
+		std::vector<LegacyObject*> objects{};
+		objects.reserve(balls);
+		for (size_t ball = 0; ball < balls; ++ball)
+		{
+			const glm::vec2 position{ x(random), y(random) };
+			const glm::vec2 velocity{ speed(random), speed(random) };
+
+			const auto entity = registry.create();
+			registry.transforms().add(entity, Transform{ position, glm::vec2{ 2.0f * kRadius }, 0.0f });
+			registry.velocities().add(entity, Velocity{ velocity });
+			registry.sprites().add(entity, Sprite{ 0, glm::vec3{ 1.0f }, SpriteLayer::kAboveParticles });
+			registry.circle_colliders().add(entity, CircleCollider{ kRadius });
+			registry.ball_states().add(entity, BallState{ false, false, false });
+
+			ball_pool.emplace_back(position, kRadius, velocity);
+			objects.emplace_back(new LegacyBall{ position, kRadius, velocity });
+		}
+
+		const auto registry_time = time_microseconds([&]() {
+			for (unsigned int frame = 0; frame < kFrames; ++frame)
+			{
+				move_entities(registry, kDt, kWidth);
+			}
+		});
+		const auto pool_time = time_microseconds([&]() {
+			for (unsigned int frame = 0; frame < kFrames; ++frame)
+			{
+				for (auto &ball : ball_pool)
+				{
+					ball.update(kDt, kWidth);
+				}
+			}
+		});
+		const auto object_time = time_microseconds([&]() {
+			for (unsigned int frame = 0; frame < kFrames; ++frame)
+			{
+				for (auto *object : objects)
+				{
+					object->update(kDt, kWidth);
+				}
+			}
+		});
+
+		// the layouts must have moved the balls the same way
+		auto same = true;
+		for (size_t ball = 0; ball < balls; ++ball)
+		{
+			same = same && registry.transforms().at(ball).position_.y == ball_pool[ball].y();
+			delete objects[ball];
+		}
+		passed = passed && same;
+
+		std::cout << "  " << balls << " balls: registry " << registry_time / kFrames
+			<< "us, contiguous objects " << pool_time / kFrames
+			<< "us, objects behind pointers " << object_time / kFrames << "us"
+			<< (same ? "" : " (positions DIFFER)") << "\n";
+	}
+	std::cout.flush();
+	return passed;
+}
+
+bool Benchmarks::log_push_latency()
+{
+	// bursts stay below the Logger's capacity & are flushed in between, so no
+	// push should find the buffer full
+	constexpr size_t kBurst{ Logger::kCapacity / 2 };
+	constexpr size_t kBursts{ 40 };
+	constexpr size_t kMessages{ kBurst * kBursts };
+	const char *kSyncLogPath{ "bench_log.txt" };
+
+	const auto summarize = [](const char *name, std::vector<double> &latencies) {
+		std::sort(latencies.begin(), latencies.end());
+		auto total = 0.0;
+		for (const auto latency : latencies)
+		{
+			total += latency;
+		}
+		std::cout << "  " << name << ": mean " << total / latencies.size() * 1000.0
+			<< "ns, median " << latencies[latencies.size() / 2] * 1000.0
+			<< "ns, p99 " << latencies[latencies.size() * 99 / 100] * 1000.0
+			<< "ns, max " << latencies.back() * 1000.0 << "ns\n";
+	};
+
+	std::vector<double> push_latencies(kMessages);
+	size_t dropped{ 0 };
+	for (size_t burst = 0; burst < kBursts; ++burst)
+	{
+		for (size_t message = 0; message < kBurst; ++message)
+		{
+			const auto index = burst * kBurst + message;
+			push_latencies[index] = time_microseconds([&]() {
+				LogRecord record{ LogLevel::kDebug, __FILE__, __LINE__ };
+				record << "Benchmark message " << index << ", frame took " << 16.6 << "ms";
+				dropped += Logger::push(record) ? 0 : 1;
+			});
+		}
+		Logger::flush();
+	}
+
+	std::vector<double> write_latencies(kMessages);
+	{
+		std::ofstream out{ kSyncLogPath };
+		for (size_t index = 0; index < kMessages; ++index)
+		{
+			write_latencies[index] = time_microseconds([&]() {
+				out << __FILE__ << ":" << __LINE__ << ": " << "Benchmark message " << index
+					<< ", frame took " << 16.6 << "ms" << std::endl;
+			});
+		}
+	}
+	std::remove(kSyncLogPath);
+
+	std::cout << "LOG() latency per message (" << kMessages << " messages, in bursts of " << kBurst << "):\n";
+	summarize("record & Logger::push", push_latencies);
+	summarize("format & write to file", write_latencies);
+	std::cout << "  dropped pushes: " << dropped << std::endl;
+	return dropped == 0;
+}
+
+bool Benchmarks::audio_stress(IAudioSink *sink)
+{
+	constexpr unsigned int kEventsPerMillisecond{ 10 };
+	constexpr unsigned int kMilliseconds{ 3000 };
+	// the window can start or end mid-block, so a mixer that's keeping up may
+	// still be a block short at either end
+	constexpr double kToleranceSeconds{ 2.0 * MixerAudioBackend::kFramesPerBlock / kPcmSampleRate };
+
+	auto *const counting_sink = new CountingAudioSink{ sink };
+	auto *const mixer = new MixerAudioBackend{ counting_sink };
+	AudioManager::set_backend(mixer);
+	// w/ a copy allowed per voice, this sound alone keeps every voice busy
+	const auto stress_sound = mixer->load_sound("audio/solid.wav", { MixerAudioBackend::kMaxVoices, 1 });
+
+	const auto run_phase = [&](const char *name, auto fire) {
+		const auto start = Clock::now();
+		const auto start_frames = counting_sink->frames();
+		auto next_tick = start;
+		for (unsigned int tick = 0; tick < kMilliseconds; ++tick)
+		{
+			for (unsigned int event = 0; event < kEventsPerMillisecond; ++event)
+			{
+				fire(tick * kEventsPerMillisecond + event);
+			}
+			next_tick += std::chrono::milliseconds{ 1 };
+			std::this_thread::sleep_until(next_tick);
+		}
+		const auto elapsed = to_microseconds(Clock::now() - start) / 1000000.0;
+		const auto mixed = static_cast<double>(counting_sink->frames() - start_frames) / kPcmSampleRate;
+		const auto kept_up = mixed + kToleranceSeconds >= elapsed;
+
+		std::cout << "  " << name << ": " << kMilliseconds * kEventsPerMillisecond / elapsed
+			<< " events/s, " << mixed << "s of audio mixed in " << elapsed << "s"
+			<< (kept_up ? "" : " (FELL BEHIND)") << "\n";
+		return kept_up;
+	};
+
+	std::cout << "Mixing under " << kEventsPerMillisecond * 1000 << " sound events/s ("
+		<< MixerAudioBackend::kMaxVoices << " voices):\n";
+	const auto manager_kept_up = run_phase("through AudioManager", [](const unsigned int event) {
+		switch (event % 4)
+		{
+		case 0: AudioManager::play_ball_brick_collision_sound(AudioManager::BallBrickCollisionType::kNormal); break;
+		case 1: AudioManager::play_ball_brick_collision_sound(AudioManager::BallBrickCollisionType::kSolid); break;
+		case 2: AudioManager::play_ball_brick_collision_sound(AudioManager::BallBrickCollisionType::kPowerUp); break;
+		default: AudioManager::play_ball_paddle_collision_sound(); break;
+		}
+	});
+	const auto mixer_kept_up = run_phase("straight into the mixer", [&](const unsigned int /*event*/) {
+		mixer->play_sound(stress_sound);
+	});
+	std::cout.flush();
+
+	AudioManager::shutdown();
+	return manager_kept_up && mixer_kept_up;
+}
+
+bool Benchmarks::menu_dispatch()
+{
+	constexpr size_t kOptions{ 32 };
+	constexpr unsigned int kFrames{ 100000 };
+	constexpr Time kDt{ 1.0f / 60.0f };
+	using OptionLabel = Label<32>;
+	using Option = ElementUnion<OptionLabel>;
+	using LegacyOption = LegacyElementUnion<OptionLabel>;
+
+	ElementList<Option, kOptions> options{};
+	ElementList<LegacyOption, kOptions> legacy_options{};
+	OptionLabel labels[kOptions];
+	Element *elements[kOptions];
+	for (size_t option = 0; option < kOptions; ++option)
+	{
+		options.emplace_back(OptionLabel{});
+		legacy_options.emplace_back();
+		elements[option] = &labels[option];
+	}
+	const Optional<SpriteRenderer*> no_renderer{};
+
+	const auto list_time = time_microseconds([&]() {
+		for (unsigned int frame = 0; frame < kFrames; ++frame)
+		{
+			options.update(kDt);
+			options.render(no_renderer);
+		}
+	});
+	const auto legacy_list_time = time_microseconds([&]() {
+		for (unsigned int frame = 0; frame < kFrames; ++frame)
+		{
+			legacy_options.update(kDt);
+			legacy_options.render(no_renderer);
+		}
+	});
+	const auto virtual_time = time_microseconds([&]() {
+		for (unsigned int frame = 0; frame < kFrames; ++frame)
+		{
+			for (auto *element : elements)
+			{
+				element->update(kDt);
+			}
+			for (auto *element : elements)
+			{
+				element->render(no_renderer);
+			}
+		}
+	});
+
+	// an update & a render per option per frame
+	const auto calls = 2.0 * kOptions * kFrames;
+	std::cout << "Menu dispatch per element call (" << kOptions << " options, " << kFrames << " frames):\n"
+		<< "  ElementList of ElementUnion: " << list_time * 1000.0 / calls << "ns\n"
+		<< "  ElementList of the old element pointer union: " << legacy_list_time * 1000.0 / calls << "ns\n"
+		<< "  virtual calls to the labels: " << virtual_time * 1000.0 / calls << "ns" << std::endl;
+	return true;
+}
+
+} // namespace util
\ No newline at end of file
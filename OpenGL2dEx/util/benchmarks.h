@@ -0,0 +1,63 @@
+#ifndef BENCHMARKS_H
+#define BENCHMARKS_H
+
+namespace util {
+
+class IAudioSink;
+class IResetGlProperties;
+
+// Reproducible measurements & checks for the optimized paths, run from the
+// command line (see main.cpp) instead of as part of the game.  Each prints
+// its results & returns false if a check failed, so they can be scripted
+class Benchmarks {
+public:
+	// per-frame cost of animating the viewport size, through the render target
+	// reallocating path (set_render_size) vs the composite-only one
+	// (set_display_size); needs a current context
+	static bool render_target_resize(const IResetGlProperties &gl_property_resetter);
+
+	// loads a generated 1000x1000 level from text & binary files, & checks that a
+	// binary level w/ an invalid tile code is rejected
+	static bool level_load();
+
+	// checks every compiled collision kernel against find_circle_hits_scalar over
+	// random layouts (including ones where circles exactly touch boxes), then times
+	// each over a 100x100 brick level
+	static bool collision_kernels();
+
+	// per-frame cost of the ball contact search (as in GameViewport::check_collisions)
+	// for 1, 100 & 10000 balls: inline, w/ threads started for every frame (how
+	// parallel_for used to work) & through the WorkerPool
+	static bool ball_contacts();
+
+	// per-frame cost of moving & bouncing 1000, 10000 & 100000 balls through the
+	// EntityRegistry systems vs the object layouts they replaced
+	static bool entity_layout();
+
+	// per-message latency of a LOG() call site: building a record & pushing it to
+	// the Logger vs formatting & writing it synchronously (how LOG used to work);
+	// fails if a push was dropped while the buffer had room
+	static bool log_push_latency();
+
+	// fires 10000 sound events a second for a few seconds, first through
+	// AudioManager (as the game does, so repeats are coalesced) & then straight
+	// into the mixer (every event starts or steals a voice); fails if the mixer
+	// falls behind real time.  Takes ownership of sink, which gets the mixed audio
+	static bool audio_stress(IAudioSink *sink);
+
+	// per-element cost of a menu's update & render dispatch, through an
+	// ElementList of ElementUnion options vs the old union that handed out an
+	// Element pointer vs virtual calls straight to the labels; the labels are
+	// inactive, so nothing is drawn & only the dispatch is timed
+	static bool menu_dispatch();
+
+private:
+	// singleton
+	Benchmarks()
+	{
+	}
+}; // class Benchmarks
+
+} // namespace util
+
+#endif // BENCHMARKS_H
\ No newline at end of file
@@ -0,0 +1,227 @@
+#include "collision.h"
+
+#include "logging.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#if defined(__AVX__)
+#define UTIL_COLLISION_AVX
+#include <immintrin.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define UTIL_COLLISION_SSE2
+#include <emmintrin.h>
+#endif
+
+// A fused multiply-add skips rounding the products, so a contracted path would no
+// longer match the others bit for bit; compilers contract by default when targeting
+// FMA (e.g. -mfma, /arch:AVX2), the intrinsics included, so turn it off here
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#elif defined(_MSC_VER)
+#pragma fp_contract(off)
+#elif defined(__GNUC__)
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+namespace util {
+
+namespace {
+	// Every path evaluates the same expression in the same order (no fused ops), which
+	// is what keeps the SIMD results bit-identical to the scalar ones:
+	//   d = center - (box min + half extents)
+	//   closest = clamp(d, -half extents, half extents) - d
+	//   hit = |closest|^2 <= radius^2
+	void find_circle_hits_range(const float     *x,
+								const float     *y,
+								const size_t    begin,
+								const size_t    end,
+								const glm::vec2 &half_extents,
+								const glm::vec2 &center,
+								const float     radius_squared,
+								uint8_t         *hits)
+	{
+		for (size_t i = begin; i < end; ++i)
+		{
+			const auto dx = center.x - (x[i] + half_extents.x);
+			const auto dy = center.y - (y[i] + half_extents.y);
+			const auto closest_x = std::min(std::max(dx, -half_extents.x), half_extents.x) - dx;
+			const auto closest_y = std::min(std::max(dy, -half_extents.y), half_extents.y) - dy;
+			hits[i] = static_cast<uint8_t>(closest_x * closest_x + closest_y * closest_y <= radius_squared);
+		}
+	}
+
+	void store_mask(const int mask, const size_t lanes, uint8_t *hits)
+	{
+		for (size_t lane = 0; lane < lanes; ++lane)
+		{
+			hits[lane] = static_cast<uint8_t>((mask >> lane) & 1);
+		}
+	}
+
+#ifdef UTIL_COLLISION_AVX
+	// returns how many boxes were handled (a multiple of 8)
+	size_t find_circle_hits_avx(const float     *x,
+								const float     *y,
+								const size_t    count,
+								const glm::vec2 &half_extents,
+								const glm::vec2 &center,
+								const float     radius_squared,
+								uint8_t         *hits)
+	{
+		const auto center_x = _mm256_set1_ps(center.x);
+		const auto center_y = _mm256_set1_ps(center.y);
+		const auto half_width = _mm256_set1_ps(half_extents.x);
+		const auto half_height = _mm256_set1_ps(half_extents.y);
+		const auto negative_half_width = _mm256_set1_ps(-half_extents.x);
+		const auto negative_half_height = _mm256_set1_ps(-half_extents.y);
+		const auto max_distance = _mm256_set1_ps(radius_squared);
+
+		size_t i = 0;
+		for (; i + 8 <= count; i += 8)
+		{
+			const auto dx = _mm256_sub_ps(center_x, _mm256_add_ps(_mm256_loadu_ps(x + i), half_width));
+			const auto dy = _mm256_sub_ps(center_y, _mm256_add_ps(_mm256_loadu_ps(y + i), half_height));
+			const auto closest_x = _mm256_sub_ps(_mm256_min_ps(_mm256_max_ps(dx, negative_half_width), half_width), dx);
+			const auto closest_y = _mm256_sub_ps(_mm256_min_ps(_mm256_max_ps(dy, negative_half_height), half_height), dy);
+			const auto distance = _mm256_add_ps(_mm256_mul_ps(closest_x, closest_x), _mm256_mul_ps(closest_y, closest_y));
+			store_mask(_mm256_movemask_ps(_mm256_cmp_ps(distance, max_distance, _CMP_LE_OQ)), 8, hits + i);
+		}
+		return i;
+	}
+#endif
+
+#ifdef UTIL_COLLISION_SSE2
+	// returns how many boxes past begin were handled (a multiple of 4)
+	size_t find_circle_hits_sse2(const float     *x,
+								 const float     *y,
+								 const size_t    begin,
+								 const size_t    count,
+								 const glm::vec2 &half_extents,
+								 const glm::vec2 &center,
+								 const float     radius_squared,
+								 uint8_t         *hits)
+	{
+		const auto center_x = _mm_set1_ps(center.x);
+		const auto center_y = _mm_set1_ps(center.y);
+		const auto half_width = _mm_set1_ps(half_extents.x);
+		const auto half_height = _mm_set1_ps(half_extents.y);
+		const auto negative_half_width = _mm_set1_ps(-half_extents.x);
+		const auto negative_half_height = _mm_set1_ps(-half_extents.y);
+		const auto max_distance = _mm_set1_ps(radius_squared);
+
+		auto i = begin;
+		for (; i + 4 <= count; i += 4)
+		{
+			const auto dx = _mm_sub_ps(center_x, _mm_add_ps(_mm_loadu_ps(x + i), half_width));
+			const auto dy = _mm_sub_ps(center_y, _mm_add_ps(_mm_loadu_ps(y + i), half_height));
+			const auto closest_x = _mm_sub_ps(_mm_min_ps(_mm_max_ps(dx, negative_half_width), half_width), dx);
+			const auto closest_y = _mm_sub_ps(_mm_min_ps(_mm_max_ps(dy, negative_half_height), half_height), dy);
+			const auto distance = _mm_add_ps(_mm_mul_ps(closest_x, closest_x), _mm_mul_ps(closest_y, closest_y));
+			store_mask(_mm_movemask_ps(_mm_cmple_ps(distance, max_distance)), 4, hits + i);
+		}
+		return i - begin;
+	}
+#endif
+
+#ifdef UTIL_VERIFY_SIMD_COLLISION
+	void verify_against_scalar(const float     *x,
+							   const float     *y,
+							   const size_t    count,
+							   const glm::vec2 &half_extents,
+							   const glm::vec2 &center,
+							   const float     radius,
+							   const uint8_t   *hits)
+	{
+		std::vector<uint8_t> expected(count);
+		find_circle_hits_scalar(x, y, count, half_extents, center, radius, expected.data());
+		ASSERT(count == 0 || std::memcmp(expected.data(), hits, count) == 0, "SIMD collision results differ from scalar");
+	}
+#endif
+} // namespace
+
+	CollisionKernel best_collision_kernel()
+	{
+#if defined(UTIL_COLLISION_AVX)
+		return CollisionKernel::kAvx;
+#elif defined(UTIL_COLLISION_SSE2)
+		return CollisionKernel::kSse2;
+#else
+		return CollisionKernel::kScalar;
+#endif
+	}
+
+	void find_circle_hits(const CollisionKernel kernel,
+						  const float           *x,
+						  const float           *y,
+						  const size_t          count,
+						  const glm::vec2       &half_extents,
+						  const glm::vec2       &center,
+						  const float           radius,
+						  uint8_t               *hits)
+	{
+		ASSERT(kernel <= best_collision_kernel(), "Collision kernel not compiled in");
+		const auto radius_squared = radius * radius;
+		size_t done = 0;
+#ifdef UTIL_COLLISION_AVX
+		if (kernel == CollisionKernel::kAvx)
+		{
+			done += find_circle_hits_avx(x, y, count, half_extents, center, radius_squared, hits);
+		}
+#endif
+#ifdef UTIL_COLLISION_SSE2
+		if (kernel != CollisionKernel::kScalar)
+		{
+			done += find_circle_hits_sse2(x, y, done, count, half_extents, center, radius_squared, hits);
+		}
+#endif
+		find_circle_hits_range(x, y, done, count, half_extents, center, radius_squared, hits);
+
+#ifdef UTIL_VERIFY_SIMD_COLLISION
+		verify_against_scalar(x, y, count, half_extents, center, radius, hits);
+#endif
+	}
+
+	void find_circle_hits(const float     *x,
+						  const float     *y,
+						  const size_t    count,
+						  const glm::vec2 &half_extents,
+						  const glm::vec2 &center,
+						  const float     radius,
+						  uint8_t         *hits)
+	{
+		find_circle_hits(best_collision_kernel(), x, y, count, half_extents, center, radius, hits);
+	}
+
+	void find_circle_hits(const float     *x,
+						  const float     *y,
+						  const size_t    count,
+						  const glm::vec2 &half_extents,
+						  const glm::vec2 *centers,
+						  const float     *radii,
+						  const size_t    circle_count,
+						  uint8_t         *hits)
+	{
+		// each circle streams over the boxes once; the box arrays stay in cache between
+		// circles as long as a level's positions fit (8 bytes per brick)
+		for (size_t circle = 0; circle < circle_count; ++circle)
+		{
+			find_circle_hits(x, y, count, half_extents, centers[circle], radii[circle], hits + circle * count);
+		}
+	}
+
+	void find_circle_hits_scalar(const float     *x,
+								 const float     *y,
+								 const size_t    count,
+								 const glm::vec2 &half_extents,
+								 const glm::vec2 &center,
+								 const float     radius,
+								 uint8_t         *hits)
+	{
+		find_circle_hits_range(x, y, 0, count, half_extents, center, radius * radius, hits);
+	}
+
+} // namespace util
\ No newline at end of file
@@ -0,0 +1,71 @@
+#ifndef COLLISION_H
+#define COLLISION_H
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+// Define to check every SIMD batch against the scalar kernel (slow; debugging only)
+//#define UTIL_VERIFY_SIMD_COLLISION
+
+namespace util {
+
+// Circle vs. axis-aligned box tests over packed (structure of arrays) boxes.
+// All boxes share half_extents; box i spans [x[i], x[i] + 2 * half_extents.x] etc.
+// hits[i] is set to 1 if the circle overlaps (or touches) box i, else 0.
+// Uses squared distances throughout & runs 8 (AVX) or 4 (SSE2) boxes at a time
+// when the compiler targets those, w/ results identical to the scalar version
+// (collision.cpp is compiled w/o floating-point contraction, so no path uses FMA).
+void find_circle_hits(const float     *x,
+					  const float     *y,
+					  size_t          count,
+					  const glm::vec2 &half_extents,
+					  const glm::vec2 &center,
+					  float           radius,
+					  uint8_t         *hits);
+
+// Same test for several circles; hits holds circle_count rows of count bytes
+void find_circle_hits(const float     *x,
+					  const float     *y,
+					  size_t          count,
+					  const glm::vec2 &half_extents,
+					  const glm::vec2 *centers,
+					  const float     *radii,
+					  size_t          circle_count,
+					  uint8_t         *hits);
+
+// SIMD kernels, narrowest first; a build has every kernel up to the widest its
+// compiler targets (see best_collision_kernel())
+enum class CollisionKernel {
+	kScalar,
+	kSse2,
+	kAvx,
+}; // enum class CollisionKernel
+
+// widest kernel this build has; it's the one find_circle_hits uses
+CollisionKernel best_collision_kernel();
+
+// find_circle_hits w/ a specific kernel (no wider than best_collision_kernel());
+// lets the kernels be checked & timed against each other
+void find_circle_hits(CollisionKernel kernel,
+					  const float     *x,
+					  const float     *y,
+					  size_t          count,
+					  const glm::vec2 &half_extents,
+					  const glm::vec2 &center,
+					  float           radius,
+					  uint8_t         *hits);
+
+// Reference implementation; the SIMD paths must match it exactly
+void find_circle_hits_scalar(const float     *x,
+							 const float     *y,
+							 size_t          count,
+							 const glm::vec2 &half_extents,
+							 const glm::vec2 &center,
+							 float           radius,
+							 uint8_t         *hits);
+
+} // namespace util
+
+#endif // COLLISION_H
\ No newline at end of file
@@ -4,8 +4,11 @@
 #include "types.h"
 
 #include "array_helpers.h"
+#include "input.h"
 #include "sprite_renderer.h"
 
+#include <type_traits>
+
 namespace util {
 	// TODO(sasiala): add is_active_ to element class and a getter function
 	// for the classes which inherit from this.  Can set it in activate &deactivate
@@ -14,9 +17,17 @@ public:
 	Element(const bool is_active)
 		: is_active_{is_active}
 		, default_active_state_{is_active}
+		, dirty_{ true }
 	{
 	}
 
+	// declared so the virtual destructor doesn't suppress the implicit moves
+	// of everything derived from Element
+	Element(const Element&) = default;
+	Element(Element&&) = default;
+	Element &operator=(const Element&) = default;
+	Element &operator=(Element&&) = default;
+
 	virtual ~Element()
 	{
 	}
@@ -27,6 +38,7 @@ public:
 	{
 		initialize_impl(projection);
 		is_active_ = default_active_state_;
+		dirty_ = true;
 	}
 
 	void update(const Time dt)
@@ -38,12 +50,14 @@ public:
 	{
 		activate_impl();
 		is_active_ = true;
+		dirty_ = true;
 	}
 
 	void deactivate()
 	{
 		deactivate_impl();
 		is_active_ = false;
+		dirty_ = true;
 	}
 
 	// TODO(sasiala): when optional is improved, swith back to 
@@ -53,19 +67,107 @@ public:
 		render_impl(parent_sprite_renderer);
 	}
 
-	void set_key(const KeyId key_id, const bool val)
+	// only the focused element is given input; it passes it on to whichever
+	// of its children has focus
+	void process_input(const InputState &input, const Time dt)
 	{
-		set_key_impl(key_id, val);
+		process_input_impl(input, dt);
 	}
 
-	void process_input(float dt)
+	bool is_active() const
 	{
-		process_input_impl(dt);
+		return is_active_;
 	}
 
-	bool is_active() const
+	// true if the element would render differently than it did when
+	// clear_dirty() was last called, so a cached rendering of it is stale
+	bool is_dirty() const
 	{
-		return is_active_;
+		return dirty_ || is_dirty_impl();
+	}
+
+	void clear_dirty()
+	{
+		dirty_ = false;
+		clear_dirty_impl();
+	}
+
+	// The calls above for an element whose final type is known (see
+	// ElementUnion): ElementType's *_impl is called by name rather than
+	// through the vtable.  ElementType has to befriend Element
+	template <typename ElementType>
+	static void initialize_final(ElementType &element, const glm::mat4 &projection)
+	{
+		static_assert(std::is_final<ElementType>::value, "Only a final type's *_impl is sure to be the override");
+		element.ElementType::initialize_impl(projection);
+		Element &base = element;
+		base.is_active_ = base.default_active_state_;
+		base.dirty_ = true;
+	}
+
+	template <typename ElementType>
+	static void update_final(ElementType &element, const Time dt)
+	{
+		static_assert(std::is_final<ElementType>::value, "Only a final type's *_impl is sure to be the override");
+		element.ElementType::update_impl(dt);
+	}
+
+	template <typename ElementType>
+	static void activate_final(ElementType &element)
+	{
+		static_assert(std::is_final<ElementType>::value, "Only a final type's *_impl is sure to be the override");
+		element.ElementType::activate_impl();
+		Element &base = element;
+		base.is_active_ = true;
+		base.dirty_ = true;
+	}
+
+	template <typename ElementType>
+	static void deactivate_final(ElementType &element)
+	{
+		static_assert(std::is_final<ElementType>::value, "Only a final type's *_impl is sure to be the override");
+		element.ElementType::deactivate_impl();
+		Element &base = element;
+		base.is_active_ = false;
+		base.dirty_ = true;
+	}
+
+	template <typename ElementType>
+	static void render_final(ElementType &element, const Optional<SpriteRenderer*> parent_sprite_renderer)
+	{
+		static_assert(std::is_final<ElementType>::value, "Only a final type's *_impl is sure to be the override");
+		element.ElementType::render_impl(parent_sprite_renderer);
+	}
+
+	template <typename ElementType>
+	static void process_input_final(ElementType &element, const InputState &input, const Time dt)
+	{
+		static_assert(std::is_final<ElementType>::value, "Only a final type's *_impl is sure to be the override");
+		element.ElementType::process_input_impl(input, dt);
+	}
+
+	template <typename ElementType>
+	static bool is_dirty_final(const ElementType &element)
+	{
+		static_assert(std::is_final<ElementType>::value, "Only a final type's *_impl is sure to be the override");
+		const Element &base = element;
+		return base.dirty_ || element.ElementType::is_dirty_impl();
+	}
+
+	template <typename ElementType>
+	static void clear_dirty_final(ElementType &element)
+	{
+		static_assert(std::is_final<ElementType>::value, "Only a final type's *_impl is sure to be the override");
+		Element &base = element;
+		base.dirty_ = false;
+		element.ElementType::clear_dirty_impl();
+	}
+
+protected:
+	// for changes to how the element looks
+	void mark_dirty()
+	{
+		dirty_ = true;
 	}
 
 private:
@@ -74,12 +176,19 @@ private:
 	virtual void activate_impl() = 0;
 	virtual void deactivate_impl() = 0;
 	virtual void render_impl(Optional<SpriteRenderer*> parent_sprite_renderer) = 0;
-	virtual void set_key_impl(KeyId key_id, bool val) = 0;
-	// TODO(sasiala): improve event handling
-	virtual void process_input_impl(Time dt) = 0;
+	virtual void process_input_impl(const InputState &input, Time dt) = 0;
+	// containers override these to include their children
+	virtual bool is_dirty_impl() const
+	{
+		return false;
+	}
+	virtual void clear_dirty_impl()
+	{
+	}
 
 	bool is_active_;
 	bool default_active_state_;
+	bool dirty_;
 }; // class Element
 
 inline void conditionally_activate(Element &e, bool activate)
@@ -106,10 +215,10 @@ namespace ElementLambdas {
 	static auto deactivate_pointer = [](Element *e) { e->deactivate(); };
 	static auto render = [](Element &e, Optional<SpriteRenderer*> parent_sprite_renderer) { e.render(parent_sprite_renderer); };
 	static auto render_pointer = [](Element *e, Optional<SpriteRenderer*> parent_sprite_renderer) { e->render(parent_sprite_renderer); };
-	static auto set_key = [](Element &e, const KeyId key_id, const bool val) { e.set_key(key_id, val); };
-	static auto set_key_pointer = [](Element *e, const KeyId key_id, const bool val) { e->set_key(key_id, val); };
-	static auto process_input = [](Element &e, const Time dt) { e.process_input(dt); };
-	static auto process_input_pointer = [](Element *e, const Time dt) { e->process_input(dt); };
+	static auto process_input = [](Element &e, const InputState &input, const Time dt) { e.process_input(input, dt); };
+	static auto process_input_pointer = [](Element *e, const InputState &input, const Time dt) { e->process_input(input, dt); };
+	static auto clear_dirty = [](Element &e) { e.clear_dirty(); };
+	static auto clear_dirty_pointer = [](Element *e) { e->clear_dirty(); };
 }
 
 } // namespace util
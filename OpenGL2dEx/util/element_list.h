@@ -9,7 +9,9 @@
 #include "text_toggle.h"
 #include "union.h"
 
+#include <new>
 #include <type_traits>
+#include <utility>
 
 namespace util {
 
@@ -26,7 +28,8 @@ public:
 
 	template<typename ElementType,
 		typename = std::enable_if_t<and<std::is_base_of<Element, Types>...>::value>,
-		typename = std::enable_if_t<impl::are_types_valid_for_union<Types...>()>>
+		typename = std::enable_if_t<impl::are_types_valid_for_union<Types...>()>,
+		typename = std::enable_if_t<impl::enable_set_v<ElementType, Types...>>>
 	ElementUnion(const ElementType &element)
 		: Element{ false }
 		, element_{ element }
@@ -39,62 +42,58 @@ public:
 	{
 	}
 
+	ElementUnion(ElementUnion<Types...> &&other)
+		: Element{ std::move(other) }
+		, element_{ std::move(other.element_) }
+	{
+	}
+
+	ElementUnion &operator=(const ElementUnion<Types...> &other) = default;
+	ElementUnion &operator=(ElementUnion<Types...> &&other) = default;
+
 	template<typename ElementType>
 	ElementType& get()
 	{
-		return element_.get<ElementType>();
+		return element_.template get<ElementType>();
 	}
 
 private:
+	// each call is one jump through the union's table, straight to the held
+	// type's *_impl; the element types are final, so nothing else is virtual
 	void initialize_impl(const glm::mat4 &projection) override
 	{
-		ASSERT(element_ptr(), "Element pointer uninitialized");
-
-		element_ptr()->initialize(projection);
+		element_.visit([&projection](auto &element) { Element::initialize_final(element, projection); });
 	}
 	void update_impl(Time dt) override
 	{
-		ASSERT(element_ptr(), "Element pointer uninitialized");
-
-		element_ptr()->update(dt);
+		element_.visit([dt](auto &element) { Element::update_final(element, dt); });
 	}
 	void activate_impl() override
 	{
-		ASSERT(element_ptr(), "Element pointer uninitialized");
-
-		element_ptr()->activate();
+		element_.visit([](auto &element) { Element::activate_final(element); });
 	}
 	void deactivate_impl() override
 	{
-		ASSERT(element_ptr(), "Element pointer uninitialized");
-
-		element_ptr()->deactivate();
+		element_.visit([](auto &element) { Element::deactivate_final(element); });
 	}
 	void render_impl(Optional<SpriteRenderer*> parent_sprite_renderer) override
 	{
-		ASSERT(element_ptr(), "Element pointer uninitialized");
-
-		element_ptr()->render(parent_sprite_renderer);
+		element_.visit([&parent_sprite_renderer](auto &element) { Element::render_final(element, parent_sprite_renderer); });
 	}
-	void set_key_impl(KeyId key_id, bool val) override
+	void process_input_impl(const InputState &input, Time dt) override
 	{
-		ASSERT(element_ptr(), "Element pointer uninitialized");
-
-		element_ptr()->set_key(key_id, val);
+		element_.visit([&input, dt](auto &element) { Element::process_input_final(element, input, dt); });
 	}
-	void process_input_impl(Time dt) override
+	bool is_dirty_impl() const override
 	{
-		ASSERT(element_ptr(), "Element pointer uninitialized");
-
-		element_ptr()->process_input(dt);
+		return element_.visit([](const auto &element) { return Element::is_dirty_final(element); });
 	}
-
-	Element *element_ptr()
+	void clear_dirty_impl() override
 	{
-		return element_.get_data_ptr();
+		element_.visit([](auto &element) { Element::clear_dirty_final(element); });
 	}
 
-	UnionWithDataPtr<Element, Types...> element_;
+	Union<Types...> element_;
 }; // class ElementUnion
 
 template<typename ELEMENT_TYPE, size_t MAX_OBJECTS,
@@ -134,10 +133,39 @@ public:
 	}
 
 	void push_back(const ListObject &obj)
+	{
+		emplace_back(obj);
+	}
+
+	void push_back(ListObject &&obj)
+	{
+		emplace_back(std::move(obj));
+	}
+
+	// the slot past the end is always a default constructed object, so it's
+	// destroyed & the new object is constructed in its place
+	template<typename ...Args>
+	ListObject& emplace_back(Args&&... args)
 	{
 		ASSERT(size_ < kMaxObjects, "No room in list");
 
-		list_[size_++] = obj;
+		auto &slot = list_[size_++];
+		slot.~ListObject();
+		new(&slot) ListObject(std::forward<Args>(args)...);
+		mark_dirty();
+		return slot;
+	}
+
+	// emptied slots are default constructed again, as emplace_back expects
+	void clear()
+	{
+		for (Index index = 0; index < size_; ++index)
+		{
+			list_[index].~ListObject();
+			new(&list_[index]) ListObject();
+		}
+		size_ = 0;
+		mark_dirty();
 	}
 
 	// TODO(sasiala): should be passed a size to know which elements
@@ -188,11 +216,23 @@ private:
 		};
 		apply_with_count(list_, size_, lambda, parent_sprite_renderer);
 	}
-	void set_key_impl(KeyId /*key_id*/, bool /*val*/) override
+	void process_input_impl(const InputState& /*input*/, float /*dt*/) override
+	{
+	}
+	bool is_dirty_impl() const override
 	{
+		for (Index index = 0; index < size_; ++index)
+		{
+			if (list_[index].is_dirty())
+			{
+				return true;
+			}
+		}
+		return false;
 	}
-	void process_input_impl(float /*dt*/) override
+	void clear_dirty_impl() override
 	{
+		apply_with_count(list_, size_, ElementLambdas::clear_dirty);
 	}
 
 	ObjectArray list_;
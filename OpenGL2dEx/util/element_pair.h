@@ -11,7 +11,7 @@ namespace util {
 template <typename T1, 
 		  typename T2, 
 		  typename = std::enable_if_t<and<std::is_base_of<Element, T1>, std::is_base_of<Element, T2>>::value>>
-class ElementPair : public Element {
+class ElementPair final : public Element {
 public:
 	using Type1 = T1;
 	using Type2 = T2;
@@ -39,6 +39,8 @@ public:
 	}
 
 private:
+	friend class Element; // for the *_final calls
+
 	// Element
 	void initialize_impl(const glm::mat4 &projection) override
 	{
@@ -65,15 +67,19 @@ private:
 		one_.render(parent_sprite_renderer);
 		two_.render(parent_sprite_renderer);
 	}
-	void set_key_impl(const KeyId key_id, const bool val) override
+	void process_input_impl(const InputState &input, const float dt) override
+	{
+		one_.process_input(input, dt);
+		two_.process_input(input, dt);
+	}
+	bool is_dirty_impl() const override
 	{
-		one_.set_key(key_id, val);
-		two_.set_key(key_id, val);
+		return one_.is_dirty() || two_.is_dirty();
 	}
-	void process_input_impl(const float dt) override
+	void clear_dirty_impl() override
 	{
-		one_.process_input(dt);
-		two_.process_input(dt);
+		one_.clear_dirty();
+		two_.clear_dirty();
 	}
 
 	Type1 one_;
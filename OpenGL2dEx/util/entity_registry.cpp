@@ -0,0 +1,60 @@
+#include "entity_registry.h"
+
+namespace util {
+
+EntityRegistry::EntityRegistry(const size_t capacity)
+	: capacity_{ capacity }
+	, entity_count_{ 0 }
+	, next_entity_{ 0 }
+	, free_entities_{}
+	, transforms_{ capacity }
+	, velocities_{ capacity }
+	, sprites_{ capacity }
+	, circle_colliders_{ capacity }
+	, ball_states_{ capacity }
+{
+	free_entities_.reserve(capacity_);
+}
+
+Entity EntityRegistry::create()
+{
+	ASSERT(!full(), "No room for another entity");
+
+	++entity_count_;
+	if (!free_entities_.empty())
+	{
+		const auto entity = free_entities_.back();
+		free_entities_.pop_back();
+		return entity;
+	}
+	return next_entity_++;
+}
+
+void EntityRegistry::destroy(const Entity entity)
+{
+	ASSERT(entity < next_entity_ && entity_count_ > 0, "Invalid entity");
+
+	transforms_.remove(entity);
+	velocities_.remove(entity);
+	sprites_.remove(entity);
+	circle_colliders_.remove(entity);
+	ball_states_.remove(entity);
+
+	free_entities_.push_back(entity);
+	--entity_count_;
+}
+
+void EntityRegistry::clear()
+{
+	transforms_.clear();
+	velocities_.clear();
+	sprites_.clear();
+	circle_colliders_.clear();
+	ball_states_.clear();
+
+	free_entities_.clear();
+	next_entity_ = 0;
+	entity_count_ = 0;
+}
+
+} // namespace util
\ No newline at end of file
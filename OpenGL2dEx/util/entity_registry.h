@@ -0,0 +1,253 @@
+#ifndef ENTITY_REGISTRY_H
+#define ENTITY_REGISTRY_H
+
+#include "logging.h"
+#include "resource_mgr.h"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace util {
+
+// An entity is just an id; what it is depends on which components it has.
+// Ids are reused after destroy(), so don't hold on to one past that
+using Entity = uint32_t;
+constexpr Entity kNoEntity{ UINT32_MAX };
+
+// components; plain data, no behaviour (that's in entity_systems.h).  There's no
+// lifetime component: nothing in the registry expires (particles keep their own
+// arrays & power-up effects their own timers), so it would have no system using it
+struct Transform {
+	glm::vec2 position_; // top left
+	glm::vec2 size_;
+	float     rotation_;
+};
+
+struct Velocity {
+	glm::vec2 velocity_;
+};
+
+// sprites are drawn a layer at a time, so other draws (e.g. particles) can go between
+enum class SpriteLayer : uint8_t {
+	kBelowParticles,
+	kAboveParticles,
+};
+
+struct Sprite {
+	ResourceManager::Texture2DId texture_id_;
+	glm::vec3                    color_;
+	SpriteLayer                  layer_;
+};
+
+// a circle of radius_ centered in the entity's transform; entities w/o one
+// collide as their transform's box
+struct CircleCollider {
+	float radius_;
+};
+
+struct BallState {
+	bool stuck_; // on the paddle, waiting to be launched
+	bool sticky_;
+	bool pass_through_;
+};
+
+// Dense storage for one component type (a "sparse set").  Components are
+// packed w/o gaps in [0, size()), so systems iterate them linearly; an
+// entity -> dense index table makes lookup, add & remove O(1).  Removing
+// moves the last component into the gap, so dense order isn't stable.
+// Storage is reserved for capacity entities up front & never reallocates
+template <typename Component>
+class ComponentArray {
+public:
+	explicit ComponentArray(const size_t capacity)
+		: components_{}
+		, entities_{}
+		, dense_indices_(capacity, kAbsent)
+	{
+		components_.reserve(capacity);
+		entities_.reserve(capacity);
+	}
+
+	ComponentArray(const ComponentArray&) = delete;
+	ComponentArray &operator=(const ComponentArray&) = delete;
+
+	Component &add(const Entity entity, const Component &component)
+	{
+		ASSERT(entity < dense_indices_.size(), "Entity out of bounds");
+		ASSERT(!has(entity), "Entity already has this component");
+
+		dense_indices_[entity] = static_cast<uint32_t>(components_.size());
+		components_.push_back(component);
+		entities_.push_back(entity);
+		return components_.back();
+	}
+
+	// no-op if the entity doesn't have this component
+	void remove(const Entity entity)
+	{
+		if (!has(entity))
+		{
+			return;
+		}
+
+		const auto index = dense_indices_[entity];
+		const auto last_entity = entities_.back();
+		components_[index] = components_.back();
+		entities_[index] = last_entity;
+		dense_indices_[last_entity] = index;
+		dense_indices_[entity] = kAbsent;
+		components_.pop_back();
+		entities_.pop_back();
+	}
+
+	void clear()
+	{
+		for (const auto entity : entities_)
+		{
+			dense_indices_[entity] = kAbsent;
+		}
+		components_.clear();
+		entities_.clear();
+	}
+
+	bool has(const Entity entity) const
+	{
+		return entity < dense_indices_.size() && dense_indices_[entity] != kAbsent;
+	}
+
+	Component &get(const Entity entity)
+	{
+		ASSERT(has(entity), "Entity doesn't have this component");
+		return components_[dense_indices_[entity]];
+	}
+
+	const Component &get(const Entity entity) const
+	{
+		ASSERT(has(entity), "Entity doesn't have this component");
+		return components_[dense_indices_[entity]];
+	}
+
+	size_t size() const
+	{
+		return components_.size();
+	}
+
+	// dense access, for systems iterating every component of this type
+	Component &at(const size_t index)
+	{
+		return components_[index];
+	}
+
+	const Component &at(const size_t index) const
+	{
+		return components_[index];
+	}
+
+	Entity entity_at(const size_t index) const
+	{
+		return entities_[index];
+	}
+
+private:
+	static constexpr uint32_t kAbsent{ UINT32_MAX };
+
+	std::vector<Component> components_;
+	std::vector<Entity>    entities_; // owner of each component
+	std::vector<uint32_t>  dense_indices_; // by entity; kAbsent if it has no such component
+}; // class ComponentArray
+
+template <typename Component>
+constexpr uint32_t ComponentArray<Component>::kAbsent;
+
+// Owns every entity & its components.  Capacity is fixed at construction, so
+// creating entities & adding components never allocates
+class EntityRegistry {
+public:
+	explicit EntityRegistry(size_t capacity);
+
+	EntityRegistry(const EntityRegistry&) = delete;
+	EntityRegistry &operator=(const EntityRegistry&) = delete;
+
+	Entity create();
+	// removes the entity's components & frees its id
+	void destroy(Entity entity);
+	void clear();
+
+	bool full() const
+	{
+		return entity_count_ == capacity_;
+	}
+
+	size_t capacity() const
+	{
+		return capacity_;
+	}
+
+	ComponentArray<Transform> &transforms()
+	{
+		return transforms_;
+	}
+
+	const ComponentArray<Transform> &transforms() const
+	{
+		return transforms_;
+	}
+
+	ComponentArray<Velocity> &velocities()
+	{
+		return velocities_;
+	}
+
+	const ComponentArray<Velocity> &velocities() const
+	{
+		return velocities_;
+	}
+
+	ComponentArray<Sprite> &sprites()
+	{
+		return sprites_;
+	}
+
+	const ComponentArray<Sprite> &sprites() const
+	{
+		return sprites_;
+	}
+
+	ComponentArray<CircleCollider> &circle_colliders()
+	{
+		return circle_colliders_;
+	}
+
+	const ComponentArray<CircleCollider> &circle_colliders() const
+	{
+		return circle_colliders_;
+	}
+
+	ComponentArray<BallState> &ball_states()
+	{
+		return ball_states_;
+	}
+
+	const ComponentArray<BallState> &ball_states() const
+	{
+		return ball_states_;
+	}
+
+private:
+	size_t              capacity_;
+	size_t              entity_count_;
+	Entity              next_entity_; // lowest id never handed out
+	std::vector<Entity> free_entities_; // destroyed ids, reused first
+
+	ComponentArray<Transform>      transforms_;
+	ComponentArray<Velocity>       velocities_;
+	ComponentArray<Sprite>         sprites_;
+	ComponentArray<CircleCollider> circle_colliders_;
+	ComponentArray<BallState>      ball_states_;
+}; // class EntityRegistry
+
+} // namespace util
+
+#endif // ENTITY_REGISTRY_H
\ No newline at end of file
@@ -0,0 +1,66 @@
+#include "entity_systems.h"
+
+#include "sprite_renderer.h"
+
+namespace util {
+
+void move_entities(EntityRegistry &registry, const float dt, const float width)
+{
+	auto &velocities = registry.velocities();
+	auto &transforms = registry.transforms();
+	const auto &ball_states = registry.ball_states();
+	for (size_t index = 0; index < velocities.size(); ++index)
+	{
+		const auto entity = velocities.entity_at(index);
+		const auto is_ball = ball_states.has(entity);
+		if (is_ball && ball_states.get(entity).stuck_)
+		{
+			continue;
+		}
+
+		auto &transform = transforms.get(entity);
+		auto &velocity = velocities.at(index).velocity_;
+		transform.position_ += velocity * dt;
+		if (!is_ball)
+		{
+			continue;
+		}
+
+		if (transform.position_.x <= 0.0f)
+		{
+			velocity.x = -velocity.x;
+			transform.position_.x = 0.0f;
+		}
+		else if (transform.position_.x + transform.size_.x >= width)
+		{
+			velocity.x = -velocity.x;
+			transform.position_.x = width - transform.size_.x;
+		}
+
+		if (transform.position_.y <= 0.0f)
+		{
+			velocity.y = -velocity.y;
+			transform.position_.y = 0.0f;
+		}
+	}
+}
+
+void draw_sprites(const EntityRegistry &registry, SpriteRenderer &renderer, const SpriteLayer layer)
+{
+	const auto &sprites = registry.sprites();
+	const auto &transforms = registry.transforms();
+	for (size_t index = 0; index < sprites.size(); ++index)
+	{
+		const auto &sprite = sprites.at(index);
+		if (sprite.layer_ != layer)
+		{
+			continue;
+		}
+
+		const auto &transform = transforms.get(sprites.entity_at(index));
+		renderer.draw(sprite.texture_id_,
+			transform.position_, transform.size_, transform.rotation_, sprite.color_);
+	}
+}
+
+} // namespace util
\ No newline at end of file
@@ -0,0 +1,23 @@
+#ifndef ENTITY_SYSTEMS_H
+#define ENTITY_SYSTEMS_H
+
+#include "entity_registry.h"
+
+namespace util {
+
+class SpriteRenderer;
+
+// Systems: each runs one piece of behaviour over every entity w/ the components
+// it needs, walking the component arrays in dense order
+
+// moves entities by their velocity; balls stuck to the paddle stay put, & the
+// rest bounce off the left, right & top of a world width wide.  Bouncing is done
+// in the same pass, so each ball's components are only looked up once a frame
+void move_entities(EntityRegistry &registry, float dt, float width);
+
+// draws the sprites in the given layer
+void draw_sprites(const EntityRegistry &registry, SpriteRenderer &renderer, SpriteLayer layer);
+
+} // namespace util
+
+#endif // ENTITY_SYSTEMS_H
\ No newline at end of file
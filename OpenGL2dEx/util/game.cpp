@@ -1,7 +1,7 @@
 #include "game.h"
 
+#include "allocation_counter.h"
 #include "audio_manager.h"
-#include "ball_object.h"
 #include "logging.h"
 #include "gl_debug.h"
 #include "particle_generator.h"
@@ -16,6 +16,8 @@
 namespace util
 {
 	Game::GameSpeedMultiplier Game::game_speed_multiplier_{ 1.0f };
+	bool Game::low_latency_input_{ false };
+	constexpr const char *Game::kLevelPaths[];
 
 	namespace {
 		Dimension animate_dimension(Dimension current, Dimension target, int dx)
@@ -51,12 +53,14 @@ namespace util
 		Dimension width,
 		Dimension height)
 		: state_{ GameState::kMainMenu }
-		, keys_{}
-		, keys_processed_{}
 		, width_{ width }
 		, height_{ height }
+		, input_queue_{}
+		, action_map_{}
+		, input_state_{}
+		, latched_dt_{ 0.0f }
 		, game_viewport_{ gl_property_resetter, width, height }
-		, main_menu_{ width, height }
+		, main_menu_{ gl_property_resetter, width, height }
 		, sprite_renderer_{ nullptr }
 		, sprite_shader_id_{}
 		, current_level_{ 0 }
@@ -100,6 +104,8 @@ namespace util
 
 		game_viewport_.initialize(projection);
 		game_viewport_.set_game_state_callback(*this);
+		// level selection previews switch between these, so build them all up front
+		game_viewport_.preload_levels(kLevelPaths, kMaxLevels);
 
 		main_menu_.initialize(projection);
 		main_menu_.set_menu_handler(*this);
@@ -110,8 +116,6 @@ namespace util
 
 		main_menu_.update_levels(kLevelNames, current_level_);
 
-		AudioManager::play_background_music(AudioManager::GameState::kActive, true);
-
 		open_main_menu();
 
 		check_for_gl_errors();
@@ -119,13 +123,35 @@ namespace util
 
 	void Game::process_input(float dt)
 	{
+		input_queue_.drain(action_map_, input_state_);
+
+		// the start of this dt was covered by the late latch last frame
+		const auto input_dt = std::max(dt - latched_dt_, 0.0f);
+		latched_dt_ = 0.0f;
+
 		if (GameState::kActive == state_)
 		{
-			game_viewport_.process_input(game_speed_multiplier_ * dt);
+			game_viewport_.process_input(input_state_, game_speed_multiplier_ * input_dt);
 		}
 		else if (GameState::kMainMenu == state_)
 		{
-			main_menu_.process_input(dt);
+			main_menu_.process_input(input_state_, input_dt);
+		}
+
+		// presses & releases from the late latch are kept for the next call
+		input_state_.begin_tick();
+	}
+
+	void Game::late_latch_input(const float dt)
+	{
+		ASSERT(low_latency_input_, "Input is only late-latched in low latency mode");
+
+		input_queue_.drain(action_map_, input_state_);
+		// only movement that was applied is taken off the next update
+		if (GameState::kActive == state_ &&
+			game_viewport_.late_latch_input(input_state_, game_speed_multiplier_ * dt))
+		{
+			latched_dt_ = dt;
 		}
 	}
 
@@ -160,17 +186,12 @@ namespace util
 		check_for_gl_errors();
 	}
 
-	void Game::set_key(size_t key, bool val)
+	void Game::resize_framebuffer(const Dimension width, const Dimension height)
 	{
-		ASSERT(key < kNumKeys, "Key out of bounds");
-		keys_[key] = val;
-		if (!val)
-		{
-			keys_processed_[key] = false;
-		}
-
-		game_viewport_.set_key(key, val);
-		main_menu_.set_key(key, val);
+		// the viewport is loaded at the full window size, so its scene is rendered
+		// at the full framebuffer size; when shrunk, it's only scaled on display
+		game_viewport_.set_render_resolution(width, height);
+		main_menu_.set_render_resolution(width, height);
 	}
 
 	void Game::handle_game_viewport_action_impl(const Action reason)
@@ -191,6 +212,7 @@ namespace util
 
 	void Game::change_level_impl(const LevelSelectionMenu::MenuIndex index)
 	{
+		AllocationCounter::expect_allocations();
 		ASSERT(index >= 0 && index < kMaxLevels, "Unexpected menu index");
 		game_viewport_.load_level(kLevelPaths[index]);
 		current_level_ = index;
@@ -216,17 +238,21 @@ namespace util
 
 	void Game::open_main_menu()
 	{
+		AllocationCounter::expect_allocations();
 		game_viewport_.deactivate();
 		main_menu_.activate();
 		state_ = GameState::kMainMenu;
+		AudioManager::play_background_music(AudioManager::GameState::kMenu, true);
 	}
 
 	void Game::open_level_selection(const bool animate)
 	{
+		AllocationCounter::expect_allocations();
 		main_menu_.update_current_level(current_level_);
 		main_menu_.open_level_selection_next_activate();
 		main_menu_.activate();
 		state_ = GameState::kMainMenu;
+		AudioManager::play_background_music(AudioManager::GameState::kMenu, true);
 		show_small_game_viewport(animate);
 	}
 
@@ -252,6 +278,7 @@ namespace util
 
 	void Game::close_main_menu()
 	{
+		AllocationCounter::expect_allocations();
 		main_menu_.deactivate();
 		
 		const float dw = viewport_animation_dw();
@@ -260,6 +287,7 @@ namespace util
 		const auto end_pos = glm::vec2{ 0.0f, 0.0f };
 		viewport_animation_ = { true, dw, dh, end_pos, start_pos, width_, height_, static_cast<Dimension>(.5 * width_), static_cast<Dimension>(.5 * height_) };
 		state_ = GameState::kActive;
+		AudioManager::play_background_music(AudioManager::GameState::kActive, true);
 		game_viewport_.activate();
 	}
 
@@ -1,6 +1,7 @@
 #ifndef GAME_H
 #define GAME_H
 
+#include "input.h"
 #include "main_menu.h"
 #include "game_level.h"
 #include "game_viewport.h"
@@ -30,12 +31,25 @@ namespace util {
 
 		void initialize();
 
+		// applies the input queued since the last call, then hands it to
+		// whichever of the viewport & menu has focus
 		void process_input(float dt);
 		void update(float dt);
 		void render();
 
-		static constexpr size_t kNumKeys{ 1024 };
-		void set_key(size_t key, bool val);
+		// low latency mode only: the loop polls for input again right before
+		// rendering, & paddle movement for the dt since process_input() is
+		// applied then, rather than a frame later
+		void late_latch_input(float dt);
+
+		// called when the window's framebuffer changes size
+		void resize_framebuffer(Dimension width, Dimension height);
+
+		// from the window system's key callback; applied on the next process_input()
+		void queue_key_event(const InputEvent &event)
+		{
+			input_queue_.push(event);
+		}
 
 		enum class GameState {
 			kActive,
@@ -59,6 +73,16 @@ namespace util {
 			return game_speed_multiplier_;
 		}
 
+		static void set_low_latency_input(const bool enabled)
+		{
+			low_latency_input_ = enabled;
+		}
+
+		static bool low_latency_input()
+		{
+			return low_latency_input_;
+		}
+
 	private:
 		// GameViewport::ActionHandler
 		void handle_game_viewport_action_impl(Action reason) override;
@@ -107,10 +131,13 @@ namespace util {
 		static constexpr size_t kMaxLevels{ util::count_of(kLevelPaths) };
 
 		GameState state_;
-		bool      keys_[kNumKeys];
-		bool      keys_processed_[kNumKeys];
 		Dimension width_, height_;
 
+		InputQueue  input_queue_;
+		ActionMap   action_map_;
+		InputState  input_state_;
+		float       latched_dt_; // already applied by late_latch_input()
+
 		GameViewport game_viewport_;
 		MainMenu         main_menu_;
 
@@ -122,6 +149,7 @@ namespace util {
 
 		// TODO(sasiala): I don't think this should be static, it's just temporarily convenient
 		static GameSpeedMultiplier game_speed_multiplier_;
+		static bool                low_latency_input_;
 
 		// TODO(sasiala): is there a less cluttered way to do this?  Could move the
 		// function definitions, but they're so simple that it would almost be more 
@@ -45,8 +45,6 @@ namespace {
 		, title_label_{ make_label<TitleLabel::max_size()>(LabelId::kTitle, 0, 0) }
 		, subtitle_label_{ make_label<SubtitleLabel::max_size()>(LabelId::kSubtitle, 0, 0)}
 		, options_{}
-		, keys_pressed_{}
-		, keys_processed_{}
 		, handler_{nullptr}
 	{
 	}
@@ -58,8 +56,6 @@ namespace {
 		, title_label_{ make_label<TitleLabel::max_size()>(LabelId::kTitle, width, height) }
 		, subtitle_label_{ make_label<SubtitleLabel::max_size()>(LabelId::kSubtitle, width, height) }
 		, options_{}
-		, keys_pressed_{}
-		, keys_processed_{}
 		, handler_{&handler}
 	{
 		for (auto i = size_t{ 0 }; i < kMaxOptions; ++i)
@@ -111,8 +107,6 @@ namespace {
 	void GameEndedOverlay::activate_impl()
 	{
 		apply(all_element_members_, ElementLambdas::activate_pointer);
-		fill(keys_pressed_, false);
-		fill(keys_processed_, false);
 	}
 	
 	void GameEndedOverlay::deactivate_impl()
@@ -130,56 +124,25 @@ namespace {
 		apply(all_element_members_, ElementLambdas::render_pointer, parent_sprite_renderer);
 	}
 	
-	void GameEndedOverlay::set_key_impl(const KeyId key_id, const bool val)
+	void GameEndedOverlay::process_input_impl(const InputState &input, const Time dt)
 	{
 		if (!is_active())
 		{
 			return;
 		}
+		apply(all_element_members_, ElementLambdas::process_input_pointer, input, dt);
 
-		const auto converted_id = convert_id(key_id);
-		if (converted_id == ButtonsHandled::kUnknown)
-		{
-			LOG("Unhandled key ID");
-		}
-		else
-		{
-			keys_pressed_[to_index(convert_id(key_id))] = val;
-
-			if (!val)
-			{
-				keys_processed_[to_index(convert_id(key_id))] = false;
-			}
-		}
-
-		apply(all_element_members_, ElementLambdas::set_key_pointer, key_id, val);
-	}
-	
-	void GameEndedOverlay::process_input_impl(const Time dt)
-	{
-		if (!is_active())
-		{
-			return;
-		}
-		apply(all_element_members_, ElementLambdas::process_input_pointer, dt);
-
-		if (keys_pressed_[to_index(ButtonsHandled::kLevelSelection)] && 
-			!keys_processed_[to_index(ButtonsHandled::kLevelSelection)])
+		if (input.pressed(InputAction::kOpenLevelSelection))
 		{
 			handler_->handle_game_overlay_event(Handler::Event::kOpenLevelSelection);
-			keys_processed_[to_index(ButtonsHandled::kLevelSelection)] = true;
 		}
-		if (keys_pressed_[to_index(ButtonsHandled::kMainMenu)] &&
-			!keys_processed_[to_index(ButtonsHandled::kMainMenu)])
+		if (input.pressed(InputAction::kOpenMainMenu))
 		{
 			handler_->handle_game_overlay_event(Handler::Event::kOpenMainMenu);
-			keys_processed_[to_index(ButtonsHandled::kMainMenu)] = true;
 		}
-		if (keys_pressed_[to_index(ButtonsHandled::kRestartGame)] &&
-			!keys_processed_[to_index(ButtonsHandled::kRestartGame)])
+		if (input.pressed(InputAction::kRestartGame))
 		{
 			handler_->handle_game_overlay_event(Handler::Event::kRestartGame);
-			keys_processed_[to_index(ButtonsHandled::kRestartGame)] = true;
 		}
 	}
 } // namespace util
\ No newline at end of file
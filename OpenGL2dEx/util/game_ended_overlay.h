@@ -6,8 +6,6 @@
 #include "element_list.h"
 #include "label.h"
 
-#include <GLFW/glfw3.h>
-
 namespace util {
 
 class GameEndedOverlay : public Element
@@ -61,47 +59,7 @@ private:
 	void activate_impl() override;
 	void deactivate_impl() override;
 	void render_impl(Optional<SpriteRenderer*> parent_sprite_renderer) override;
-	void set_key_impl(KeyId key_id, bool val) override;
-	// TODO(sasiala): improve event handling
-	void process_input_impl(Time dt) override;
-
-	enum class ButtonsHandled {
-		kMainMenu = 0,
-		kLevelSelection,
-		kRestartGame,
-		kNumButtons,
-		kUnknown,
-	};
-	size_t to_index(const ButtonsHandled button_id)
-	{
-		ASSERT(ButtonsHandled::kNumButtons > button_id,
-			"Cannot convert to index (out of bounds)");
-		return static_cast<size_t>(button_id);
-	}
-	// TODO(sasiala): improve how key IDs are defined
-	ButtonsHandled convert_id(const KeyId button)
-	{
-		auto converted_id = ButtonsHandled::kUnknown;
-		switch (button)
-		{
-		case GLFW_KEY_M:
-			converted_id = ButtonsHandled::kMainMenu;
-			break;
-		case GLFW_KEY_L:
-			converted_id = ButtonsHandled::kLevelSelection;
-			break;
-		case GLFW_KEY_R:
-			converted_id = ButtonsHandled::kRestartGame;
-			break;
-		default:
-			LOG("Unknown button id: " + std::to_string(button));
-			break;
-		}
-
-		return converted_id;
-	}
-	bool keys_pressed_[static_cast<size_t>(ButtonsHandled::kNumButtons)];
-	bool keys_processed_[static_cast<size_t>(ButtonsHandled::kNumButtons)];
+	void process_input_impl(const InputState &input, Time dt) override;
 
 	Dimension loaded_width_;
 	Dimension loaded_height_;
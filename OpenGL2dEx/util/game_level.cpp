@@ -1,118 +1,109 @@
 #include "game_level.h"
 
-#include "gl_debug.h"
+#include "collision.h"
 #include "logging.h"
 #include "resource_mgr.h"
+#include "sprite_renderer.h"
 
-#include <fstream>
-#include <sstream>
+#include <algorithm>
+#include <cmath>
 
 namespace util {
 
-void GameLevel::load(const char                   *file,
-					 unsigned int                 level_width,
-					 unsigned int                 level_height,
-					 ResourceManager::Texture2DId block_solid_texture_id,
-					 ResourceManager::Texture2DId block_texture_id)
-{
-	block_solid_texture_id_ = block_solid_texture_id;
-	block_texture_id_ = block_texture_id;
-
-	bricks_.clear();
-
-	unsigned int tile_code{};
-	std::string line;
-	std::ifstream fstream(file);
-	std::vector<std::vector<unsigned int>> tile_data{};
-
-	if (fstream)
-	{
-		while (std::getline(fstream, line))
-		{
-			std::istringstream sstream(line);
-			std::vector<unsigned int> row{};
-			while (sstream >> tile_code)
-				row.push_back(tile_code);
-			tile_data.push_back(row);
-		}
+constexpr size_t GameLevel::kBricksPerBatch;
 
-		if (!tile_data.empty())
-		{
-			initialize(tile_data, level_width, level_height);
-		}
-	}
+void GameLevel::load(const char   *file,
+					 unsigned int level_width,
+					 unsigned int level_height)
+{
+	loaded_template_.load(file, level_width, level_height);
+	use_template(loaded_template_);
+}
 
-	check_for_gl_errors();
+void GameLevel::use_template(const LevelTemplate &level_template)
+{
+	template_ = &level_template;
+	// only allocates if this level has more bricks than any before it
+	alive_bits_.resize((brick_count() + kBitsPerWord - 1) / kBitsPerWord);
+	reset();
 }
 
-void GameLevel::draw(SpriteRenderer &renderer)
+void GameLevel::reset()
 {
-	for (auto &tile : bricks_)
+	// every brick (solid ones included) starts out alive; bits past the last brick stay clear
+	std::fill(alive_bits_.begin(), alive_bits_.end(), ~BitWord{ 0 });
+	const auto used_bits = brick_count() % kBitsPerWord;
+	if (used_bits != 0)
 	{
-		if (!tile.is_destroyed())
-		{
-			tile.draw(renderer);
-		}
+		alive_bits_.back() = (BitWord{ 1 } << used_bits) - 1;
 	}
+	bricks_alive_ = template_->destructible_bricks();
 }
 
-void GameLevel::initialize(std::vector<std::vector<unsigned int>> tile_data,
-	unsigned int level_width, unsigned int level_height)
+size_t GameLevel::find_bricks_near(const glm::vec2 &center,
+								   const float     radius,
+								   BrickIndex      *bricks,
+								   const size_t    max_bricks) const
 {
-	ASSERT(!tile_data.empty(), "No tile data");
-	// calculate dimensions
-	unsigned int height = tile_data.size();
-	unsigned int width = tile_data.at(0).size();
-	float unit_width = level_width / static_cast<float>(width);
-	float unit_height = level_height / static_cast<float>(height);
+	const auto columns = static_cast<int>(template_->grid_columns());
+	const auto rows = static_cast<int>(template_->grid_rows());
+	if (columns == 0 || rows == 0)
+	{
+		return 0;
+	}
 
-	bricks_alive_ = 0;
+	// broad phase: the cells under the circle's bounding box
+	const auto &size = brick_size();
+	const auto first_column = std::max(0, static_cast<int>(std::floor((center.x - radius) / size.x)));
+	const auto last_column = std::min(columns - 1, static_cast<int>(std::floor((center.x + radius) / size.x)));
+	const auto first_row = std::max(0, static_cast<int>(std::floor((center.y - radius) / size.y)));
+	const auto last_row = std::min(rows - 1, static_cast<int>(std::floor((center.y + radius) / size.y)));
+	if (first_column > last_column || first_row > last_row)
+	{
+		return 0;
+	}
 
-	for (unsigned int y = 0; y < height; ++y)
+	// bricks are stored row-major, so on each row the bricks in those cells are one
+	// contiguous range of indices, which the batch kernel then tests exactly.  Rows
+	// are taken in order, so the results stay in index order
+	size_t found = 0;
+	uint8_t hits[kBricksPerBatch];
+	for (auto row = first_row; row <= last_row; ++row)
 	{
-		for (unsigned int x = 0; x < width; ++x)
+		const auto row_start = static_cast<size_t>(row) * columns;
+		const auto first = template_->bricks_before(row_start + first_column);
+		const auto end = template_->bricks_before(row_start + last_column + 1);
+		for (auto batch = first; batch < end; batch += kBricksPerBatch)
 		{
-			glm::vec2 pos(unit_width * x, unit_height * y);
-			glm::vec2 size(unit_width, unit_height);
-
-			auto current_val = tile_data.at(y).at(x);
-			if (current_val == 1)
-			{
-				GameObject object(pos, size, ResourceManager::get_texture(block_solid_texture_id_), { glm::vec3(0.8f, 0.8f, 0.7f) }, {});
-				object.set_solid(true);
-				bricks_.push_back(object);
-			}
-			else if (current_val > 1)
+			const auto batch_count = std::min<size_t>(kBricksPerBatch, end - batch);
+			util::find_circle_hits(template_->x() + batch, template_->y() + batch, batch_count,
+				size / 2.0f, center, radius, hits);
+			for (size_t i = 0; i < batch_count; ++i)
 			{
-				// TODO(sasiala): better way to do colors
-				auto color = glm::vec3(1.0f);
-				switch (current_val)
+				if (hits[i] && !is_brick_destroyed(batch + i))
 				{
-				case static_cast<unsigned int>(TileColor::kOne) :
-					color = glm::vec3(1.0f);
-					break;
-				case static_cast<unsigned int>(TileColor::kTwo) :
-					color = glm::vec3(0.2f, 0.6f, 1.0f);
-					break;
-				case static_cast<unsigned int>(TileColor::kThree) :
-					color = glm::vec3(0.0f, 0.7f, 0.0f);
-					break;
-				case static_cast<unsigned int>(TileColor::kFour) :
-					color = glm::vec3(0.8f, 0.8f, 0.4f);
-					break;
-				case static_cast<unsigned int>(TileColor::kFive) :
-					color = glm::vec3(1.0f, 0.5f, 0.0f);
-					break;
-				default:
-					ASSERT(false, "Unknown tile value: " + std::to_string(current_val));
+					bricks[found++] = static_cast<BrickIndex>(batch + i);
+					if (found == max_bricks)
+					{
+						return found;
+					}
 				}
-
-				bricks_.push_back(GameObject(pos, size, ResourceManager::get_texture(block_texture_id_), { color }, {}));
-				++bricks_alive_;
 			}
 		}
+	}
+	return found;
+}
 
-		check_for_gl_errors();
+void GameLevel::draw(SpriteRenderer &renderer)
+{
+	const auto count = brick_count();
+	for (size_t i = 0; i < count; ++i)
+	{
+		if (!is_brick_destroyed(i))
+		{
+			renderer.draw(is_brick_solid(i) ? block_solid_texture_id_ : block_texture_id_,
+				brick_position(i), brick_size(), 0.0f, template_->color(i));
+		}
 	}
 }
 
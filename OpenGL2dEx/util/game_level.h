@@ -1,9 +1,11 @@
 #ifndef GAME_LEVEL_H
 #define GAME_LEVEL_H
 
-#include "game_object.h"
+#include "level_template.h"
 #include "logging.h"
 #include "resource_mgr.h"
+
+#include <cstdint>
 #include <vector>
 
 namespace util {
@@ -13,23 +15,42 @@ class SpriteRenderer;
 class GameLevel
 {
 public:
-	typedef std::vector<GameObject> BrickContainer;
+	using BrickIndex = LevelTemplate::BrickIndex;
 
 	GameLevel()
 		: block_solid_texture_id_{}
 		, block_texture_id_{}
-		, bricks_{}
+		, loaded_template_{}
+		, template_{ &loaded_template_ }
+		, alive_bits_{}
 		, bricks_alive_{}
 	{
 	}
 
-	// TODO(sasiala): shouldn't need to load each time we reset level
-	// load from file
-	void load(const char                   *file, 
-			  unsigned int                 level_width, 
-			  unsigned int                 level_height, 
-			  ResourceManager::Texture2DId block_solid_texture_id,
-			  ResourceManager::Texture2DId block_texture_id);
+	// template_ may point at loaded_template_
+	GameLevel(const GameLevel&) = delete;
+	GameLevel &operator=(const GameLevel&) = delete;
+
+	// load from file; either a text (.lvl) or compiled binary (.blvl) level, detected
+	// from the file's contents.  The bricks built here are never modified afterwards,
+	// so reset() can restore the level from them
+	void load(const char   *file, 
+			  unsigned int level_width, 
+			  unsigned int level_height);
+
+	void set_textures(ResourceManager::Texture2DId block_solid_texture_id,
+					  ResourceManager::Texture2DId block_texture_id)
+	{
+		block_solid_texture_id_ = block_solid_texture_id;
+		block_texture_id_ = block_texture_id;
+	}
+
+	// plays the given (e.g. cached) level instead; it must outlive its use here.
+	// Only the alive bits are touched, the bricks aren't copied
+	void use_template(const LevelTemplate &level_template);
+
+	// restores every brick of the loaded level; no file I/O or allocation
+	void reset();
 
 	void draw(SpriteRenderer &renderer);
 	
@@ -38,39 +59,75 @@ public:
 		return (bricks_alive_ == 0);
 	}
 
-	const BrickContainer &bricks() const
+	size_t brick_count() const
+	{
+		return template_->brick_count();
+	}
+
+	glm::vec2 brick_position(const size_t index) const
 	{
-		return bricks_;
+		return template_->position(index);
+	}
+
+	// all bricks of a level share a size
+	const glm::vec2 &brick_size() const
+	{
+		return template_->brick_size();
+	}
+
+	bool is_brick_solid(const size_t index) const
+	{
+		return template_->is_solid(index);
+	}
+
+	// writes the indices of up to max_bricks live bricks overlapping a circle at center
+	// to bricks, in index order, & returns how many were written.  Only the grid cells
+	// under the circle's bounding box are looked at, row by row, so the cost depends on
+	// the circle's size rather than the level's
+	size_t find_bricks_near(const glm::vec2 &center, float radius, BrickIndex *bricks, size_t max_bricks) const;
+
+	bool is_brick_destroyed(const size_t index) const
+	{
+		ASSERT(index < brick_count(), "Brick index out of bounds");
+		return (alive_bits_[index / kBitsPerWord] & bit_mask(index)) == 0;
 	}
 
 	void set_brick_destroyed(const size_t index, 
 							 const bool destroyed)
 	{
-		ASSERT(bricks_alive_ > 0, "No bricks available to destroy");
-		auto &brick = bricks_.at(index);
-		ASSERT(!brick.is_solid(), "Brick is indestructible (solid brick)");
-		ASSERT(!brick.is_destroyed(), "Brick is already destroyed");
+		ASSERT(!is_brick_solid(index), "Brick is indestructible (solid brick)");
+		ASSERT(is_brick_destroyed(index) != destroyed, "Brick is already in requested state");
 
-		brick.set_destroyed(destroyed);
-		--bricks_alive_;
+		auto &word = alive_bits_[index / kBitsPerWord];
+		if (destroyed)
+		{
+			ASSERT(bricks_alive_ > 0, "No bricks available to destroy");
+			word &= ~bit_mask(index);
+			--bricks_alive_;
+		}
+		else
+		{
+			word |= bit_mask(index);
+			++bricks_alive_;
+		}
 	}
 
 private:
-	void initialize(std::vector<std::vector<unsigned int>> tile_data,
-		unsigned int level_width, unsigned int level_height);
+	using BitWord = uint64_t;
+	static constexpr size_t kBitsPerWord{ 64 };
+	static constexpr size_t kBricksPerBatch{ 32 }; // bricks per find_circle_hits() call
+	static BitWord bit_mask(const size_t index)
+	{
+		return BitWord{ 1 } << (index % kBitsPerWord);
+	}
 
 	ResourceManager::Texture2DId block_solid_texture_id_;
 	ResourceManager::Texture2DId block_texture_id_;
-	BrickContainer               bricks_;
-	size_t                       bricks_alive_;
-
-	enum class TileColor {
-		kOne = 1,
-		kTwo = 2,
-		kThree = 3,
-		kFour = 4,
-		kFive = 5,
-	};
+
+	LevelTemplate        loaded_template_; // level loaded from file by load()
+	const LevelTemplate *template_; // level being played; immutable
+	std::vector<BitWord> alive_bits_; // one bit per brick in template_, set while alive
+	size_t               bricks_alive_; // destructible bricks still alive
 };
 
 } // namespace util
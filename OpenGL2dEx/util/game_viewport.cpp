@@ -1,62 +1,88 @@
 #include "game_viewport.h"
 
 #include "audio_manager.h"
-#include "ball_object.h"
 #include "array_helpers.h"
+#include "entity_systems.h"
 #include "logging.h"
 #include "gl_debug.h"
+#include "parallel_for.h"
 #include "particle_generator.h"
 #include "post_processor.h"
+#include "resolution_controller.h"
 
 #include <algorithm>
+#include <cmath>
+#include <cstdio>
 
 namespace util {
+	constexpr size_t GameViewport::kMaxBrickContacts;
+	constexpr size_t GameViewport::kMinBallsPerThread;
+	size_t GameViewport::extra_balls_{ 0 };
+
+	const GameViewport::PowerUpKind GameViewport::kPowerUpKinds[] = {
+		{ 75, glm::vec3(0.5f, 0.5f, 1.0f), 0.0f },   // speed
+		{ 75, glm::vec3(1.0f, 0.5f, 1.0f), 20.0f },  // sticky
+		{ 75, glm::vec3(0.5f, 1.0f, 0.5f), 10.0f },  // pass through
+		{ 75, glm::vec3(1.0f, 0.6f, 0.4f), 0.0f },   // pad size increase
+		{ 15, glm::vec3(1.0f, 0.3f, 0.3f), 15.0f },  // confuse
+		{ 15, glm::vec3(0.9f, 0.25f, 0.25f), 15.0f }, // chaos
+		{ 75, glm::vec3(0.4f, 0.9f, 1.0f), 0.0f },   // multi-ball
+	};
+
 	GameViewport::GameViewport(IResetGlProperties &gl_property_resetter,
 							   Dimension width, 
 							   Dimension height)
 		: Element{false}
-		, keys_pressed_{}
-		, keys_processed_{}
 		, gl_property_resetter_{ gl_property_resetter }
 		, width_{ width }
 		, height_{ height }
 		, game_state_callback_{ nullptr }
 		, level_{}
 		, level_path_{ nullptr }
+		, level_cache_{}
 		, background_texture_id_{}
 		, block_texture_id_{}
 		, block_solid_texture_id_{}
 		, paddle_texture_id_{}
-		, pup_chaos_texture_id_{}
-		, pup_confuse_texture_id_{}
-		, pup_size_texture_id_{}
-		, pup_pass_through_texture_id_{}
-		, pup_speed_texture_id_{}
-		, pup_sticky_texture_id_{}
+		, power_up_texture_ids_{}
 		, particle_shader_id_{}
 		, effects_shader_id_{}
+		, blur_shader_id_{}
+		, edge_shader_id_{}
+		, invert_shader_id_{}
 		, sprite_shader_id_{}
 		, font_shader_id_{}
 		, default_font_id_{}
 		, state_{State::kUnknown}
 		, lives_{ kInitialLifeCount }
-		, paddle_{ nullptr }
-		, ball_{ nullptr }
+		, entities_{ kMaxEntities }
+		, paddle_{ kNoEntity }
+		, ball_contacts_{}
 		, particle_generator_{ nullptr }
 		, effects_{ nullptr }
+		, resolution_controller_{ nullptr }
 		, shake_time_{ 0.0f }
 		, power_ups_{}
+		, power_up_time_left_{}
 		, game_ended_overlay_{*this, width, height}
 	{
 	}
 
 	void GameViewport::set_size(Dimension width, Dimension height)
 	{
-		// TODO(sasiala): should make separation between loaded height/width (width_ & height_)
-		// and render height/width (set here) very clear.  ball, paddle, brick size should all remain
-		// the same since being loaded, but the rendered width and height can change (which will just
-		// stretch the texture)
-		effects_->set_size(width, height);
+		// the loaded width/height (width_ & height_) & the render targets stay fixed;
+		// the displayed size only stretches the composited scene
+		effects_->set_display_size(width, height);
+	}
+
+	void GameViewport::set_render_resolution(Dimension width, Dimension height)
+	{
+		if (!effects_)
+		{
+			return;
+		}
+
+		effects_->set_render_size(width, height);
 	}
 
 	void GameViewport::set_position(const glm::vec2 &position)
@@ -64,38 +90,51 @@ namespace util {
 		effects_->set_position(position);
 	}
 
-	void GameViewport::load_level(const char * const path)
+	void GameViewport::preload_levels(const char * const *paths, const size_t count)
 	{
-		// TODO(sasiala) this clearing should be acomplished by reset()
-		// call, but that currently calls load_level()
-		reset_lives();
-		power_ups_.clear();
-		effects_->clear_effects();
-		particle_generator_->clear_particles();
-		reset_player();
+		level_cache_.preload(paths, count, width_, height_ / 2);
+	}
 
+	void GameViewport::load_level(const char * const path)
+	{
 		level_path_ = path;
-		level_.load(level_path_, width_, height_ / 2,
-			block_solid_texture_id_, block_texture_id_);
+		const auto *cached_level = level_cache_.get(level_path_);
+		if (cached_level)
+		{
+			level_.use_template(*cached_level);
+		}
+		else
+		{
+			level_.load(level_path_, width_, height_ / 2);
+		}
 
-		game_ended_overlay_.deactivate();
-		state_ = State::kBefore;
+		restart_level();
 	}
 
 	void GameViewport::reset_level()
 	{
-		// TODO(sasiala): add reset to level class
-		load_level(level_path_);
+		// the level keeps its bricks once loaded, so there's no need to go back to the file
+		level_.reset();
+
+		restart_level();
 	}
 
-	void GameViewport::reset()
+	void GameViewport::restart_level()
 	{
 		reset_lives();
-		reset_level();
 		power_ups_.clear();
+		fill(power_up_time_left_, 0.0f);
 		effects_->clear_effects();
 		particle_generator_->clear_particles();
 		reset_player();
+
+		game_ended_overlay_.deactivate();
+		state_ = State::kBefore;
+	}
+
+	void GameViewport::reset()
+	{
+		reset_level();
 	}
 
 	void GameViewport::initialize_impl(const glm::mat4 &screen_projection)
@@ -104,20 +143,26 @@ namespace util {
 		background_texture_id_ = ResourceManager::load_texture(kBackgroundImagePath, false);
 		block_texture_id_ = ResourceManager::load_texture(kBlockImagePath, false);
 		block_solid_texture_id_ = ResourceManager::load_texture(kBlockSolidImagePath, false);
+		level_.set_textures(block_solid_texture_id_, block_texture_id_);
 		paddle_texture_id_ = ResourceManager::load_texture(kPaddleImagePath, true);
 		ball_texture_id_ = ResourceManager::load_texture(kBallImagePath, true);
 		particle_texture_id_ = ResourceManager::load_texture(kParticleImagePath, true);
 
-		pup_chaos_texture_id_ = ResourceManager::load_texture(kPupChaosImagePath, true);
-		pup_confuse_texture_id_ = ResourceManager::load_texture(kPupConfuseImagePath, true);
-		pup_size_texture_id_ = ResourceManager::load_texture(kPupIncreaseImagePath, true);
-		pup_pass_through_texture_id_ = ResourceManager::load_texture(kPupPassThroughImagePath, true);
-		pup_speed_texture_id_ = ResourceManager::load_texture(kPupSpeedImagePath, true);
-		pup_sticky_texture_id_ = ResourceManager::load_texture(kPupStickyImagePath, true);
+		power_up_texture_ids_[to_index(PowerUpTypes::kChaos)] = ResourceManager::load_texture(kPupChaosImagePath, true);
+		power_up_texture_ids_[to_index(PowerUpTypes::kConfuse)] = ResourceManager::load_texture(kPupConfuseImagePath, true);
+		power_up_texture_ids_[to_index(PowerUpTypes::kPadSizeIncrease)] = ResourceManager::load_texture(kPupIncreaseImagePath, true);
+		power_up_texture_ids_[to_index(PowerUpTypes::kPassThrough)] = ResourceManager::load_texture(kPupPassThroughImagePath, true);
+		power_up_texture_ids_[to_index(PowerUpTypes::kSpeed)] = ResourceManager::load_texture(kPupSpeedImagePath, true);
+		power_up_texture_ids_[to_index(PowerUpTypes::kSticky)] = ResourceManager::load_texture(kPupStickyImagePath, true);
+		// there's no multi-ball power-up texture, so the ball's stands in for it
+		power_up_texture_ids_[to_index(PowerUpTypes::kMultiBall)] = ball_texture_id_;
 
 		// shaders
 		particle_shader_id_ = ResourceManager::load_shader("shaders/particle.vs", "shaders/particle.fs", {util::nullopt});
 		effects_shader_id_ = ResourceManager::load_shader("shaders/effects.vs", "shaders/effects.fs", {util::nullopt});
+		blur_shader_id_ = ResourceManager::load_shader("shaders/post_pass.vs", "shaders/post_blur.fs", {util::nullopt});
+		edge_shader_id_ = ResourceManager::load_shader("shaders/post_pass.vs", "shaders/post_edge.fs", {util::nullopt});
+		invert_shader_id_ = ResourceManager::load_shader("shaders/post_pass.vs", "shaders/post_invert.fs", {util::nullopt});
 		sprite_shader_id_ = ResourceManager::load_shader("shaders/sprite.vs", "shaders/sprite.fs", {util::nullopt});
 		font_shader_id_ = ResourceManager::load_shader("shaders/text_2d.vs", "shaders/text_2d.fs", {util::nullopt});
 
@@ -128,23 +173,19 @@ namespace util {
 			width_ / 2.0f - paddle_size.x / 2.0f,
 			height_ - paddle_size.y
 		);
-		paddle_ = new GameObject(player_pos, paddle_size,
-			ResourceManager::get_texture(paddle_texture_id_), {}, {});
+		paddle_ = entities_.create();
+		entities_.transforms().add(paddle_, Transform{ player_pos, paddle_size, 0.0f });
+		entities_.sprites().add(paddle_, Sprite{ paddle_texture_id_, glm::vec3(1.0f), SpriteLayer::kBelowParticles });
 
-		const auto ball_radius = ball_radius_from_viewport_width();
-		const auto ball_pos = player_pos +
-			glm::vec2(paddle_->size().x / 2.0f - ball_radius,
-				-ball_radius * 2.0f);
-		const auto ball_velocity = initial_ball_velocity();
-		ball_ = new BallObject(ball_pos, ball_radius, ball_velocity,
-			ResourceManager::get_texture(ball_texture_id_));
+		ball_contacts_.reserve(kMaxBalls);
+		reset_player();
 
 		glm::mat4 projection = glm::ortho(0.0f, static_cast<float>(width_),
 			static_cast<float>(height_), 0.0f, -1.0f, 1.0f);
 
 		particle_generator_ = new ParticleGenerator(
 			ResourceManager::get_shader(particle_shader_id_),
-			ResourceManager::get_texture(particle_texture_id_),
+			particle_texture_id_,
 			kMaxParticles,
 			projection
 		);
@@ -152,11 +193,15 @@ namespace util {
 		effects_ = new PostProcessor(
 			gl_property_resetter_,
 			ResourceManager::get_shader(effects_shader_id_),
+			ResourceManager::get_shader(blur_shader_id_),
+			ResourceManager::get_shader(edge_shader_id_),
+			ResourceManager::get_shader(invert_shader_id_),
 			{ 0.0f, 0.0f },
 			width_,
 			height_,
 			screen_projection
 		);
+		resolution_controller_ = new ResolutionController{};
 
 		sprite_renderer_ = new SpriteRenderer{ ResourceManager::get_shader(sprite_shader_id_) };
 		auto &sprite_shader = ResourceManager::get_shader(sprite_shader_id_);
@@ -174,10 +219,10 @@ namespace util {
 			return;
 		}
 
-		ASSERT(ball_, "No ball defined");
+		ASSERT(ball_count() > 0, "No ball defined");
 		ASSERT(particle_generator_, "No particle generator defined");
 
-		ball_->move(dt, width_);
+		move_entities(entities_, dt, static_cast<float>(width_));
 		check_collisions();
 
 		if (state_ == State::kLost)
@@ -190,12 +235,27 @@ namespace util {
 			return;
 		}
 
-		if (ball_->position().y >= height_)
+		// balls falling off the bottom are gone; a life is only lost w/ the last one.
+		// Going backwards, destroying a ball only moves one that's already been checked
+		const auto &ball_states = entities_.ball_states();
+		for (auto index = ball_states.size(); index > 0; --index)
+		{
+			const auto ball = ball_states.entity_at(index - 1);
+			if (entities_.transforms().get(ball).position_.y >= height_)
+			{
+				entities_.destroy(ball);
+			}
+		}
+		if (ball_count() == 0)
 		{
 			kill_player();
 		}
 
-		particle_generator_->update(dt, *ball_, kNewParticlesPerUpdate, glm::vec2(ball_->radius() / 2.0f));
+		// only one ball leaves a trail; a trail per ball would need far more particles
+		const auto lead_ball = ball_states.entity_at(0);
+		const auto lead_ball_radius = entities_.circle_colliders().get(lead_ball).radius_;
+		particle_generator_->update(dt, entities_.transforms().get(lead_ball).position_,
+			entities_.velocities().get(lead_ball).velocity_, kNewParticlesPerUpdate, glm::vec2(lead_ball_radius / 2.0f));
 
 		update_power_ups(dt);
 
@@ -211,41 +271,41 @@ namespace util {
 
 	void GameViewport::activate_impl()
 	{
-		fill(keys_pressed_, false);
-		fill(keys_processed_, false);
 	}
 
 	void GameViewport::deactivate_impl()
 	{
+		if (effects_)
+		{
+			effects_->log_stats();
+		}
 	}
 
 	void GameViewport::render_impl(Optional<SpriteRenderer*> /*parent_sprite_renderer*/)
 	{
-		ASSERT(ball_, "No ball defined");
-		ASSERT(paddle_, "No paddle defined");
+		ASSERT(ball_count() > 0, "No ball defined");
+		ASSERT(paddle_ != kNoEntity, "No paddle defined");
 
 		if (!is_active())
 		{
 			return;
 		}
 
+		// scale is chosen from GPU timings a few frames old, so this never waits on the GPU
+		resolution_controller_->begin_frame();
+		effects_->set_resolution_scale(resolution_controller_->scale());
 		effects_->begin_render();
 
-		sprite_renderer_->draw(ResourceManager::get_texture(background_texture_id_),
+		sprite_renderer_->draw(background_texture_id_,
 			glm::vec2(0.0f, 0.0f), glm::vec2(width_, height_), 0.0f);
 
 		level_.draw(*sprite_renderer_);
-		paddle_->draw(*sprite_renderer_);
+		// paddle, then particles, then balls
+		draw_sprites(entities_, *sprite_renderer_, SpriteLayer::kBelowParticles);
 		particle_generator_->draw();
-		ball_->draw(*sprite_renderer_);
+		draw_sprites(entities_, *sprite_renderer_, SpriteLayer::kAboveParticles);
 
-		for (auto &i : power_ups_)
-		{
-			if (!i.is_destroyed())
-			{
-				i.draw(*sprite_renderer_);
-			}
-		}
+		render_power_ups();
 
 		render_lives();
 
@@ -253,6 +313,7 @@ namespace util {
 
 		effects_->end_render();
 		effects_->render(static_cast<float>(glfwGetTime()));
+		resolution_controller_->end_frame();
 
 		check_for_gl_errors();
 	}
@@ -285,47 +346,51 @@ namespace util {
 	}
 
 	namespace {
+		// picks the compass direction (up, right, down, left) closest to target.  Comparing
+		// the signed components is equivalent to comparing dot products w/ the normalized
+		// vector, incl. ties going to the earlier direction, w/o the sqrt & divide
 		GameViewport::Direction vector_direction(const glm::vec2 &target)
 		{
-			static const std::vector<std::pair<GameViewport::Direction, glm::vec2>> compass{
-				{ GameViewport::Direction::kUp, glm::vec2(0.0f, 1.0f) },   // up
-				{ GameViewport::Direction::kRight, glm::vec2(1.0f, 0.0f) },   // right
-				{ GameViewport::Direction::kDown, glm::vec2(0.0f, -1.0f) },  // down
-				{ GameViewport::Direction::kLeft, glm::vec2(-1.0f, 0.0f) }   // left
-			};
-
 			float max = 0.0f;
 			auto best_match = GameViewport::Direction::kUnknown;
-
-			for (auto i : compass)
+			if (target.y > max)
 			{
-				float dot_product = glm::dot(glm::normalize(target), i.second);
-				if (dot_product > max)
-				{
-					max = dot_product;
-					best_match = i.first;
-				}
+				max = target.y;
+				best_match = GameViewport::Direction::kUp;
+			}
+			if (target.x > max)
+			{
+				max = target.x;
+				best_match = GameViewport::Direction::kRight;
+			}
+			if (-target.y > max)
+			{
+				max = -target.y;
+				best_match = GameViewport::Direction::kDown;
+			}
+			if (-target.x > max)
+			{
+				best_match = GameViewport::Direction::kLeft;
 			}
 			return best_match;
 		}
 
-		bool check_collision(const GameObject &one, const GameObject &two)
+		bool check_collision(const Transform &one, const glm::vec2 &box_position, const glm::vec2 &box_size)
 		{
-			bool collision_x = one.position().x + one.size().x >= two.position().x &&
-				two.position().x + two.size().x >= one.position().x;
-			bool collision_y = one.position().y + one.size().y >= two.position().y &&
-				two.position().y + two.size().y >= one.position().y;
+			bool collision_x = one.position_.x + one.size_.x >= box_position.x &&
+				box_position.x + box_size.x >= one.position_.x;
+			bool collision_y = one.position_.y + one.size_.y >= box_position.y &&
+				box_position.y + box_size.y >= one.position_.y;
 			return collision_x && collision_y;
 		}
 
-		GameViewport::Collision check_collision(const BallObject &one, const GameObject &two)
+		GameViewport::Collision check_collision(const glm::vec2 &center, const float radius,
+												const glm::vec2 &box_position, const glm::vec2 &box_size)
 		{
-			glm::vec2 center(one.position() + one.radius());
-
-			glm::vec2 aabb_half_extents(two.size().x / 2.0f, two.size().y / 2.0f);
+			glm::vec2 aabb_half_extents(box_size.x / 2.0f, box_size.y / 2.0f);
 			glm::vec2 aabb_center(
-				two.position().x + aabb_half_extents.x,
-				two.position().y + aabb_half_extents.y
+				box_position.x + aabb_half_extents.x,
+				box_position.y + aabb_half_extents.y
 			);
 
 			glm::vec2 difference = center - aabb_center;
@@ -335,7 +400,8 @@ namespace util {
 
 			difference = closest - center;
 
-			if (glm::length(difference) <= one.radius())
+			// direction is only worked out for actual hits
+			if (glm::dot(difference, difference) <= radius * radius)
 			{
 				return std::make_tuple(true, vector_direction(difference), difference);
 			}
@@ -346,9 +412,9 @@ namespace util {
 		}
 	} // namespace
 
-	void GameViewport::handle_ball_box_collision(const Collision &collision_tuple, const size_t box_index, const GameObject &box)
+	void GameViewport::handle_ball_box_collision(const Entity ball, const Collision &collision_tuple, const size_t box_index)
 	{
-		if (!box.is_solid())
+		if (!level_.is_brick_solid(box_index))
 		{
 			level_.set_brick_destroyed(box_index, true);
 			if (level_.is_completed())
@@ -356,7 +422,7 @@ namespace util {
 				level_complete();
 			}
 
-			const auto power_ups_spawned = spawn_power_ups(box);
+			const auto power_ups_spawned = spawn_power_ups(level_.brick_position(box_index));
 			if (power_ups_spawned)
 			{
 				AudioManager::play_ball_brick_collision_sound(AudioManager::BallBrickCollisionType::kPowerUp);
@@ -378,215 +444,367 @@ namespace util {
 			AudioManager::play_ball_brick_collision_sound(AudioManager::BallBrickCollisionType::kSolid);
 		}
 
-		if (!ball_->pass_through())
+		if (!entities_.ball_states().get(ball).pass_through_)
 		{
 			const auto direction = std::get<1>(collision_tuple);
 			const auto diff_vector = std::get<2>(collision_tuple);
 			ASSERT(direction != GameViewport::Direction::kUnknown &&
 				direction != GameViewport::Direction::kNumDirections,
 				"Invalid collision direction");
+			auto &position = entities_.transforms().get(ball).position_;
+			auto &velocity = entities_.velocities().get(ball).velocity_;
+			const auto radius = entities_.circle_colliders().get(ball).radius_;
 			if (direction == GameViewport::Direction::kLeft ||
 				direction == GameViewport::Direction::kRight)
 			{
-				auto velocity = ball_->velocity();
 				velocity.x *= -1;
-				ball_->set_velocity(velocity);
 
 				// move outside of object
-				float penetration = ball_->radius() - std::abs(diff_vector.x);
+				float penetration = radius - std::abs(diff_vector.x);
 				if (direction == GameViewport::Direction::kLeft)
 				{
-					ball_->move_x(penetration);
+					position.x += penetration;
 				}
 				else
 				{
-					ball_->move_x(-penetration);
+					position.x -= penetration;
 				}
 			}
 			else // vertical collision
 			{
-				auto velocity = ball_->velocity();
 				velocity.y *= -1;
-				ball_->set_velocity(velocity);
 
 				// move outside of object
-				float penetration = ball_->radius() - std::abs(diff_vector.y);
+				float penetration = radius - std::abs(diff_vector.y);
 				if (direction == GameViewport::Direction::kUp)
 				{
-					ball_->move_y(-penetration);
+					position.y -= penetration;
 				}
 				else
 				{
-					ball_->move_y(penetration);
+					position.y += penetration;
 				}
 			}
 		}
 	}
 
-	void GameViewport::activate_power_up(const PowerUp &power_up)
+	void GameViewport::activate_power_up(const PowerUpTypes type)
 	{
-		switch (power_up.type())
+		switch (type)
 		{
-		case static_cast<PowerUp::Type>(PowerUpTypes::kSpeed) :
-			ball_->set_velocity(ball_->velocity() * 1.2f);
+		case PowerUpTypes::kSpeed:
+			for (size_t index = 0; index < ball_count(); ++index)
+			{
+				entities_.velocities().get(entities_.ball_states().entity_at(index)).velocity_ *= 1.2f;
+			}
 			break;
-		case static_cast<PowerUp::Type>(PowerUpTypes::kSticky) :
-			ball_->set_sticky(true);
-			paddle_->set_color(glm::vec3(1.0f, 0.5f, 1.0f));
+		case PowerUpTypes::kSticky:
+			for (size_t index = 0; index < ball_count(); ++index)
+			{
+				entities_.ball_states().at(index).sticky_ = true;
+			}
+			entities_.sprites().get(paddle_).color_ = glm::vec3(1.0f, 0.5f, 1.0f);
 			break;
-		case static_cast<PowerUp::Type>(PowerUpTypes::kPassThrough) :
-			ball_->set_pass_through(true);
-			ball_->set_color(glm::vec3(1.0f, 0.5f, 0.5f));
+		case PowerUpTypes::kPassThrough:
+			for (size_t index = 0; index < ball_count(); ++index)
+			{
+				entities_.ball_states().at(index).pass_through_ = true;
+				entities_.sprites().get(entities_.ball_states().entity_at(index)).color_ = glm::vec3(1.0f, 0.5f, 0.5f);
+			}
 			break;
-		case static_cast<PowerUp::Type>(PowerUpTypes::kPadSizeIncrease) :
-			paddle_->set_size(paddle_->size() + glm::vec2(50.0f, 0.0f));
+		case PowerUpTypes::kPadSizeIncrease:
+			entities_.transforms().get(paddle_).size_ += glm::vec2(50.0f, 0.0f);
 			break;
-		case static_cast<PowerUp::Type>(PowerUpTypes::kConfuse) :
+		case PowerUpTypes::kConfuse:
 			if (!effects_->chaos())
 			{
 				effects_->set_confuse(true);
 			}
-																break;
-		case static_cast<PowerUp::Type>(PowerUpTypes::kChaos) :
+			break;
+		case PowerUpTypes::kChaos:
 			if (!effects_->confuse())
 			{
 				effects_->set_chaos(true);
 			}
+			break;
+		case PowerUpTypes::kMultiBall:
+			split_balls();
+			break;
+		default:
+			ASSERT(false, "Unhandled power-up type");
+			break;
 		}
+
+		// the effect lasts until the most recently picked up power-up of its type runs out
+		const auto duration = kPowerUpKinds[to_index(type)].duration_;
+		auto &time_left = power_up_time_left_[to_index(type)];
+		time_left = std::max(time_left, duration);
 	}
 
-	void GameViewport::check_collisions()
+	void GameViewport::deactivate_power_up(const PowerUpTypes type)
 	{
-		size_t index = 0;
-		for (const auto &box : level_.bricks())
+		switch (type)
 		{
-			if (!box.is_destroyed())
+		case PowerUpTypes::kSticky:
+			for (size_t index = 0; index < ball_count(); ++index)
+			{
+				entities_.ball_states().at(index).sticky_ = false;
+			}
+			entities_.sprites().get(paddle_).color_ = glm::vec3(1.0f);
+			break;
+		case PowerUpTypes::kPassThrough:
+			for (size_t index = 0; index < ball_count(); ++index)
 			{
-				auto collision_tuple = check_collision(*ball_, box);
+				entities_.ball_states().at(index).pass_through_ = false;
+				entities_.sprites().get(entities_.ball_states().entity_at(index)).color_ = glm::vec3(1.0f);
+			}
+			break;
+		case PowerUpTypes::kConfuse:
+			effects_->set_confuse(false);
+			break;
+		case PowerUpTypes::kChaos:
+			effects_->set_chaos(false);
+			break;
+		default:
+			ASSERT(false, "Power-up type has no lasting effect");
+			break;
+		}
+	}
 
-				if (std::get<0>(collision_tuple))
+	namespace {
+		glm::vec2 rotate(const glm::vec2 &vector, const float radians)
+		{
+			const auto cos = std::cos(radians);
+			const auto sin = std::sin(radians);
+			return{ vector.x * cos - vector.y * sin, vector.x * sin + vector.y * cos };
+		}
+	} // namespace
+
+	void GameViewport::spawn_ball(const Transform &transform, const glm::vec2 &velocity,
+								  const BallState &state, const glm::vec3 &color)
+	{
+		const auto ball = entities_.create();
+		entities_.transforms().add(ball, transform);
+		entities_.velocities().add(ball, Velocity{ velocity });
+		entities_.sprites().add(ball, Sprite{ ball_texture_id_, color, SpriteLayer::kAboveParticles });
+		entities_.circle_colliders().add(ball, CircleCollider{ transform.size_.x / 2.0f });
+		entities_.ball_states().add(ball, state);
+	}
+
+	void GameViewport::destroy_balls()
+	{
+		while (ball_count() > 0)
+		{
+			entities_.destroy(entities_.ball_states().entity_at(ball_count() - 1));
+		}
+	}
+
+	void GameViewport::split_balls()
+	{
+		// every ball gets two copies heading off either side of it, as far as there's room;
+		// copies keep the original's sticky/pass-through state
+		const auto original_count = ball_count();
+		for (size_t index = 0; index < original_count; ++index)
+		{
+			const auto ball = entities_.ball_states().entity_at(index);
+			const auto transform = entities_.transforms().get(ball);
+			const auto velocity = entities_.velocities().get(ball).velocity_;
+			const auto state = entities_.ball_states().get(ball);
+			const auto color = entities_.sprites().get(ball).color_;
+			for (const auto angle : { -kSplitAngle, kSplitAngle })
+			{
+				if (entities_.full())
 				{
-					handle_ball_box_collision(collision_tuple, index, box);
-					if (state_ != State::kPlaying)
-					{
-						return;
-					}
+					return;
 				}
+				spawn_ball(transform, rotate(velocity, angle), state, color);
 			}
-			++index;
 		}
+	}
+
+	void GameViewport::handle_ball_paddle_collision(const Entity ball)
+	{
+		auto &state = entities_.ball_states().get(ball);
+		const auto &position = entities_.transforms().get(ball).position_;
+		const auto radius = entities_.circle_colliders().get(ball).radius_;
+		const auto &paddle = entities_.transforms().get(paddle_);
 
-		auto player_collision = check_collision(*ball_, *paddle_);
-		if (!ball_->stuck() && std::get<0>(player_collision))
+		// brick hits earlier this frame may have moved the ball off the paddle
+		auto player_collision = check_collision(position + radius, radius, paddle.position_, paddle.size_);
+		if (!state.stuck_ && std::get<0>(player_collision))
 		{
-			float center_board = paddle_->position().x + paddle_->size().x / 2.0f;
-			float distance = (ball_->position().x + ball_->radius()) - center_board;
-			float percentage = distance / (paddle_->size().x / 2.0f);
+			float center_board = paddle.position_.x + paddle.size_.x / 2.0f;
+			float distance = (position.x + radius) - center_board;
+			float percentage = distance / (paddle.size_.x / 2.0f);
 
 			float strength = 2.0f;
-			glm::vec2 old_velocity = ball_->velocity();
-			glm::vec2 new_velocity = ball_->velocity();
+			auto &velocity = entities_.velocities().get(ball).velocity_;
+			glm::vec2 old_velocity = velocity;
+			glm::vec2 new_velocity = velocity;
 			new_velocity.x = initial_ball_velocity().x * percentage * strength;
 			// new_velocity.y = -old_velocity.y;
 			// assuming that collision is always with top of paddle prevents sticky issue
 			new_velocity.y = -1 * abs(old_velocity.y);
 			new_velocity = glm::normalize(new_velocity) * glm::length(old_velocity);
-			ball_->set_velocity(new_velocity);
-			ball_->set_stuck(ball_->sticky());
+			velocity = new_velocity;
+			state.stuck_ = state.sticky_;
 		}
+	}
 
-		for (auto &power_up : power_ups_)
-		{
-			if (!power_up.is_destroyed())
+	void GameViewport::find_contacts(const size_t first_ball, const size_t end_ball)
+	{
+		// only reads the level & entities (& writes this ball's contacts), so ranges of
+		// balls can be handled on different threads
+		const auto &ball_states = entities_.ball_states();
+		const auto &transforms = entities_.transforms();
+		const auto &paddle = transforms.get(paddle_);
+		for (auto index = first_ball; index < end_ball; ++index)
+		{
+			const auto ball = ball_states.entity_at(index);
+			const auto radius = entities_.circle_colliders().get(ball).radius_;
+			const auto center = transforms.get(ball).position_ + radius;
+			auto &contacts = ball_contacts_[index];
+			contacts.brick_count_ = level_.find_bricks_near(center, radius, contacts.bricks_, kMaxBrickContacts);
+			contacts.paddle_ = std::get<0>(check_collision(center, radius, paddle.position_, paddle.size_));
+		}
+	}
+
+	void GameViewport::check_collisions()
+	{
+		// the grid broad phase & exact tests for every ball, spread over threads once there
+		// are enough balls to be worth it
+		ball_contacts_.resize(ball_count());
+		parallel_for(ball_count(), kMinBallsPerThread,
+			[this](const size_t first_ball, const size_t end_ball) { find_contacts(first_ball, end_ball); });
+
+		// responses change the level & balls, play sounds & spawn power-ups, so they're
+		// applied in ball order on this thread
+		for (size_t ball_index = 0; ball_index < ball_count(); ++ball_index)
+		{
+			const auto ball = entities_.ball_states().entity_at(ball_index);
+			const auto &transform = entities_.transforms().get(ball);
+			const auto radius = entities_.circle_colliders().get(ball).radius_;
+			const auto &contacts = ball_contacts_[ball_index];
+			for (size_t contact = 0; contact < contacts.brick_count_; ++contact)
 			{
-				if (power_up.position().y >= height_)
+				// an earlier ball may have destroyed this brick, & handling an earlier hit
+				// may have moved this ball out of it
+				const auto brick_index = contacts.bricks_[contact];
+				if (level_.is_brick_destroyed(brick_index))
 				{
-					power_up.set_destroyed(true);
+					continue;
 				}
-				if (check_collision(*paddle_, power_up))
+
+				auto collision_tuple = check_collision(transform.position_ + radius, radius,
+					level_.brick_position(brick_index), level_.brick_size());
+				if (std::get<0>(collision_tuple))
 				{
-					activate_power_up(power_up);
-					power_up.set_destroyed(true);
-					power_up.set_activated(true);
+					handle_ball_box_collision(ball, collision_tuple, brick_index);
+					if (state_ != State::kPlaying)
+					{
+						return;
+					}
 				}
 			}
-		}
-	}
 
-	void GameViewport::set_key_impl(KeyId key_id, bool val)
-	{
-		if (!is_active())
-		{
-			return;
+			if (contacts.paddle_)
+			{
+				handle_ball_paddle_collision(ball);
+			}
 		}
 
-		if (state_ == State::kPlaying)
+		const auto &paddle = entities_.transforms().get(paddle_);
+		for (size_t slot = 0; slot < PowerUpPool::kCapacity; ++slot)
 		{
-			const auto converted_id = convert_id(key_id);
-			if (converted_id == ButtonsHandled::kUnknown)
+			if (!power_ups_.in_use(slot))
 			{
-				LOG("Unhandled key ID");
+				continue;
 			}
-			else
+
+			const auto &power_up = power_ups_[slot];
+			if (check_collision(paddle, power_up.position_, kPowerUpSize))
 			{
-				keys_pressed_[to_index(convert_id(key_id))] = val;
-				
-				if (!val)
-				{
-					keys_processed_[to_index(convert_id(key_id))] = false;
-				}
+				const auto type = static_cast<PowerUpTypes>(power_up.type_);
+				power_ups_.release(slot);
+				activate_power_up(type);
+			}
+			else if (power_up.position_.y >= height_)
+			{
+				power_ups_.release(slot);
 			}
+		}
+	}
+
+	void GameViewport::move_paddle(const float distance)
+	{
+		entities_.transforms().get(paddle_).position_.x += distance;
 
+		// stuck balls ride along w/ the paddle
+		for (size_t index = 0; index < ball_count(); ++index)
+		{
+			if (entities_.ball_states().at(index).stuck_)
+			{
+				entities_.transforms().get(entities_.ball_states().entity_at(index)).position_.x += distance;
+			}
 		}
-		else
+	}
+
+	bool GameViewport::late_latch_input(const InputState &input, const Time dt)
+	{
+		if (!is_active() || state_ != State::kPlaying)
 		{
-			// pass event on when not playing
-			game_ended_overlay_.set_key(key_id, val);
+			return false;
+		}
+		handle_paddle_input(input, dt);
+		return true;
+	}
+
+	void GameViewport::handle_paddle_input(const InputState &input, const Time dt)
+	{
+		if (input.held(InputAction::kPaddleLeft))
+		{
+			handle_left_button(dt);
+		}
+		if (input.held(InputAction::kPaddleRight))
+		{
+			handle_right_button(dt);
 		}
 	}
 
 	void GameViewport::handle_left_button(float dt)
 	{
-		ASSERT(ball_, "No ball defined");
-		ASSERT(paddle_, "No paddle defined");
+		ASSERT(paddle_ != kNoEntity, "No paddle defined");
 
 		const auto velocity = paddle_velocity_from_viewport_width() * dt;
-		if (paddle_->position().x >= 0.0f)
+		if (entities_.transforms().get(paddle_).position_.x >= 0.0f)
 		{
-			paddle_->move_x(-velocity);
-
-			if (ball_->stuck())
-			{
-				ball_->move_x(-velocity);
-			}
+			move_paddle(-velocity);
 		}
 	}
 
 	void GameViewport::handle_right_button(float dt)
 	{
-		ASSERT(ball_, "No ball defined");
-		ASSERT(paddle_, "No paddle defined");
+		ASSERT(paddle_ != kNoEntity, "No paddle defined");
 
 		const auto velocity = paddle_velocity_from_viewport_width() * dt;
-		if (paddle_->position().x <= width_ - paddle_->size().x)
+		const auto &paddle = entities_.transforms().get(paddle_);
+		if (paddle.position_.x <= width_ - paddle.size_.x)
 		{
-			paddle_->move_x(velocity);
-
-			if (ball_->stuck())
-			{
-				ball_->move_x(velocity);
-			}
+			move_paddle(velocity);
 		}
 	}
 
 	void GameViewport::handle_launch_button()
 	{
-		ASSERT(ball_, "No ball defined");
+		ASSERT(ball_count() > 0, "No ball defined");
 
-		ball_->set_stuck(false);
+		for (size_t index = 0; index < ball_count(); ++index)
+		{
+			entities_.ball_states().at(index).stuck_ = false;
+		}
 	}
 
-	void GameViewport::process_input_impl(Time dt)
+	void GameViewport::process_input_impl(const InputState &input, Time dt)
 	{
 		if (!is_active())
 		{
@@ -596,33 +814,25 @@ namespace util {
 		if (state_ == State::kPlaying)
 		{
 			// handle game actions when the game is playing
-			if (keys_pressed_[to_index(ButtonsHandled::kLeftButton)])
-			{
-				handle_left_button(dt);
-				keys_processed_[to_index(ButtonsHandled::kLeftButton)] = true;
-			}
-			if (keys_pressed_[to_index(ButtonsHandled::kRightButton)])
-			{
-				handle_right_button(dt);
-				keys_processed_[to_index(ButtonsHandled::kRightButton)] = true;
-			}
-			if (keys_pressed_[to_index(ButtonsHandled::kLaunchButton)])
+			handle_paddle_input(input, dt);
+			if (input.held(InputAction::kLaunchBall))
 			{
 				handle_launch_button();
-				keys_processed_[to_index(ButtonsHandled::kLaunchButton)] = true;
 			}
 		}
 		else
 		{
 			// pass down event to other objects
-			game_ended_overlay_.process_input(dt);
+			game_ended_overlay_.process_input(input, dt);
 		}
 	}
 
 	void GameViewport::render_lives()
 	{
-		ResourceManager::get_font(default_font_id_).render_text("Lives: " + 
-			std::to_string(lives_), 
+		// formatted into a fixed buffer, since this runs every frame
+		char lives_text[kLivesTextSize];
+		std::snprintf(lives_text, kLivesTextSize, "Lives: %u", lives_);
+		ResourceManager::get_font(default_font_id_).render_text(lives_text, 
 			convert_ratio_from_width(kLifeText.relative_x_), 
 			convert_ratio_from_height(kLifeText.relative_y_), 
 			convert_ratio_from_height(kLifeText.scale_ratio_from_height_), 
@@ -631,15 +841,27 @@ namespace util {
 
 	void GameViewport::reset_player()
 	{
-		const auto paddle_size = paddle_size_from_viewport_size();
-		paddle_->set_size(paddle_size);
-		paddle_->set_position(glm::vec2(width_ / 2.0f - paddle_size.x / 2.0f,
-			height_ - paddle_size.y));
+		auto &paddle = entities_.transforms().get(paddle_);
+		paddle.size_ = paddle_size_from_viewport_size();
+		paddle.position_ = glm::vec2(width_ / 2.0f - paddle.size_.x / 2.0f,
+			height_ - paddle.size_.y);
 
 		const auto ball_radius = ball_radius_from_viewport_width();
 		const auto ball_velocity = initial_ball_velocity();
-		ball_->reset(paddle_->position() + glm::vec2(paddle_->size().x / 2.0f - ball_radius, 
-												-(ball_radius * 2.0f)), ball_velocity);
+		const Transform ball{ paddle.position_ + glm::vec2(paddle.size_.x / 2.0f - ball_radius,
+														   -(ball_radius * 2.0f)),
+							  glm::vec2(ball_radius * 2.0f), 0.0f };
+		const BallState ball_state{ true, false, false };
+		destroy_balls();
+		spawn_ball(ball, ball_velocity, ball_state, glm::vec3(1.0f));
+
+		// extra balls wait on the paddle w/ the player's ball, fanned out around its velocity
+		const auto extra_ball_count = std::min(extra_balls_, kMaxBalls - 1);
+		for (size_t extra = 0; extra < extra_ball_count; ++extra)
+		{
+			const auto spread = (static_cast<float>(extra + 1) / (extra_ball_count + 1) - 0.5f) * kExtraBallSpread;
+			spawn_ball(ball, rotate(ball_velocity, spread), ball_state, glm::vec3(1.0f));
+		}
 	}
 
 	void GameViewport::kill_player()
@@ -652,12 +874,6 @@ namespace util {
 			reset();
 			state_ = State::kLost;
 
-			// TODO(sasiala): temp fix for bug where holding key as 
-			// game ends will make it marked pressed when game is restarted 
-			// until the user presses and releases that key
-			fill(keys_pressed_, false);
-			fill(keys_processed_, false);
-
 			game_ended_overlay_.set_mode(GameEndedOverlay::Mode::kLost);
 			game_ended_overlay_.activate();
 		}
@@ -669,17 +885,8 @@ namespace util {
 
 	void GameViewport::delete_dynamic_data()
 	{
-		if (paddle_)
-		{
-			delete paddle_;
-		}
-		paddle_ = nullptr;
-
-		if (ball_)
-		{
-			delete ball_;
-		}
-		ball_ = nullptr;
+		entities_.clear();
+		paddle_ = kNoEntity;
 
 		if (particle_generator_)
 		{
@@ -692,6 +899,12 @@ namespace util {
 			delete effects_;
 		}
 		effects_ = nullptr;
+
+		if (resolution_controller_)
+		{
+			delete resolution_controller_;
+		}
+		resolution_controller_ = nullptr;
 	}
 
 	namespace {
@@ -701,177 +914,66 @@ namespace util {
 			unsigned int random = rand() % chance;
 			return random == 0;
 		}
-
-		// should_spawn_*() functions are just for clarifying code
-		bool should_spawn_speed()
-		{
-			return should_spawn(75);
-		}
-
-		bool should_spawn_sticky()
-		{
-			return should_spawn(75);
-		}
-
-		bool should_spawn_pass_through()
-		{
-			return should_spawn(75);
-		}
-
-		bool should_spawn_size()
-		{
-			return should_spawn(75);
-		}
-
-		bool should_spawn_confuse()
-		{
-			return should_spawn(15);
-		}
-
-		bool should_spawn_chaos()
-		{
-			return should_spawn(15);
-		}
 	} // namespace
 
-	bool GameViewport::spawn_power_ups(const GameObject &block)
+	bool GameViewport::spawn_power_ups(const glm::vec2 &position)
 	{
+		// one roll per type, in PowerUpTypes order
 		auto power_up_spawned = false;
-		ASSERT(!block.is_solid(), "Don't spawn power ups for solid blocks");
-		if (should_spawn_speed())
-		{
-			power_ups_.push_back(
-				PowerUp(static_cast<PowerUp::Type>(PowerUpTypes::kSpeed),
-					glm::vec3(0.5f, 0.5f, 1.0f), 0.0f, block.position(),
-					ResourceManager::get_texture(pup_speed_texture_id_))
-			);
-			power_up_spawned = true;
-		}
-
-		if (should_spawn_sticky())
-		{
-			power_ups_.push_back(
-				PowerUp(static_cast<PowerUp::Type>(PowerUpTypes::kSticky),
-					glm::vec3(1.0f, 0.5f, 1.0f), 20.0f, block.position(),
-					ResourceManager::get_texture(pup_sticky_texture_id_))
-			);
-			power_up_spawned = true;
-		}
-
-		if (should_spawn_pass_through())
+		for (size_t type = 0; type < static_cast<size_t>(PowerUpTypes::kNumTypes); ++type)
 		{
-			power_ups_.push_back(
-				PowerUp(static_cast<PowerUp::Type>(PowerUpTypes::kPassThrough),
-					glm::vec3(0.5f, 1.0f, 0.5f), 10.0f, block.position(),
-					ResourceManager::get_texture(pup_pass_through_texture_id_))
-			);
-			power_up_spawned = true;
-		}
-
-		if (should_spawn_size())
-		{
-			power_ups_.push_back(
-				PowerUp(static_cast<PowerUp::Type>(PowerUpTypes::kPadSizeIncrease),
-					glm::vec3(1.0f, 0.6f, 0.4f), 0.0f, block.position(),
-					ResourceManager::get_texture(pup_size_texture_id_))
-			);
-			power_up_spawned = true;
-		}
-
-		if (should_spawn_confuse())
-		{
-			power_ups_.push_back(
-				PowerUp(static_cast<PowerUp::Type>(PowerUpTypes::kConfuse),
-					glm::vec3(1.0f, 0.3f, 0.3f), 15.0f, block.position(),
-					ResourceManager::get_texture(pup_confuse_texture_id_))
-			);
-			power_up_spawned = true;
-		}
-
-		if (should_spawn_chaos())
-		{
-			power_ups_.push_back(
-				PowerUp(static_cast<PowerUp::Type>(PowerUpTypes::kChaos),
-					glm::vec3(0.9f, 0.25f, 0.25f), 15.0f, block.position(),
-					ResourceManager::get_texture(pup_chaos_texture_id_))
-			);
-			power_up_spawned = true;
+			if (should_spawn(kPowerUpKinds[type].spawn_chance_) &&
+				power_ups_.spawn(static_cast<PowerUp::Type>(type), position))
+			{
+				power_up_spawned = true;
+			}
 		}
 
 		return power_up_spawned;
 	}
 
-	bool GameViewport::is_other_power_up_active(const PowerUpTypes type)
+	void GameViewport::update_power_ups(float dt)
 	{
-		for (auto &i : power_ups_)
+		for (size_t slot = 0; slot < PowerUpPool::kCapacity; ++slot)
 		{
-			if (i.activated() && static_cast<PowerUp::Type>(type) == i.type())
+			if (power_ups_.in_use(slot))
 			{
-				return true;
+				power_ups_[slot].position_.y += kPowerUpFallSpeed * dt;
 			}
 		}
-		return false;
-	}
 
-	void GameViewport::update_power_ups(float dt)
-	{
-		for (auto &i : power_ups_)
+		for (size_t type = 0; type < static_cast<size_t>(PowerUpTypes::kNumTypes); ++type)
 		{
-			i.progress_time(dt);
-
-			if (i.activated())
+			auto &time_left = power_up_time_left_[type];
+			if (time_left > 0.0f)
 			{
-				i.set_duration(i.duration() - dt);
-				if (i.duration() <= 0.0f)
+				time_left -= dt;
+				if (time_left <= 0.0f)
 				{
-					i.set_activated(false);
-					switch (i.type())
-					{
-					case static_cast<PowerUp::Type>(PowerUpTypes::kSticky) :
-						if (!is_other_power_up_active(PowerUpTypes::kSticky))
-						{
-							ball_->set_sticky(false);
-							paddle_->set_color(glm::vec3(1.0f));
-						}
-						break;
-					case static_cast<PowerUp::Type>(PowerUpTypes::kPassThrough) :
-						if (!is_other_power_up_active(PowerUpTypes::kPassThrough))
-						{
-							ball_->set_pass_through(false);
-							ball_->set_color(glm::vec3(1.0f));
-						}
-						break;
-					case static_cast<PowerUp::Type>(PowerUpTypes::kConfuse) :
-						if (!is_other_power_up_active(PowerUpTypes::kConfuse))
-						{
-							effects_->set_confuse(false);
-						}
-						break;
-					case static_cast<PowerUp::Type>(PowerUpTypes::kChaos) :
-						if (!is_other_power_up_active(PowerUpTypes::kChaos))
-						{
-							effects_->set_chaos(false);
-						}
-					}
+					time_left = 0.0f;
+					deactivate_power_up(static_cast<PowerUpTypes>(type));
 				}
 			}
 		}
+	}
 
-		power_ups_.erase(std::remove_if(power_ups_.begin(), power_ups_.end(),
-			[](const PowerUp &power_up) {return power_up.is_destroyed() && !power_up.activated(); }),
-			power_ups_.end());
+	void GameViewport::render_power_ups()
+	{
+		for (size_t slot = 0; slot < PowerUpPool::kCapacity; ++slot)
+		{
+			if (power_ups_.in_use(slot))
+			{
+				const auto &power_up = power_ups_[slot];
+				sprite_renderer_->draw(power_up_texture_ids_[power_up.type_],
+					power_up.position_, kPowerUpSize, 0.0f, kPowerUpKinds[power_up.type_].color_);
+			}
+		}
 	}
 
 	void GameViewport::level_complete()
 	{
 		state_ = State::kWon;
 
-		// TODO(sasiala): temp fix for bug where holding key as 
-		// game ends will make it marked pressed when game is restarted 
-		// until the user presses and releases that key
-		fill(keys_pressed_, false);
-		fill(keys_processed_, false);
-
 		game_ended_overlay_.set_mode(GameEndedOverlay::Mode::kWon);
 		game_ended_overlay_.activate();
 	}
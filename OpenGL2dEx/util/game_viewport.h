@@ -1,8 +1,10 @@
 #ifndef GAME_VIEWPORT_H
 #define GAME_VIEWPORT_H
 
+#include "entity_registry.h"
 #include "game_level.h"
 #include "element.h"
+#include "level_cache.h"
 
 #include "game_ended_overlay.h"
 #include "logging.h"
@@ -16,9 +18,9 @@
 
 namespace util {
 
-class BallObject;
 class ParticleGenerator;
 class PostProcessor;
+class ResolutionController;
 class IResetGlProperties;
 
 class GameViewport : public Element
@@ -35,6 +37,9 @@ public:
 	using Collision = std::tuple<bool, Direction, glm::vec2>;
 	using LifeCount = unsigned int;
 
+	// fewest balls worth handing to another thread when looking for contacts
+	static constexpr size_t kMinBallsPerThread{ 256 };
+
 	class ActionHandler {
 	public:
 		enum class Action {
@@ -72,6 +77,11 @@ public:
 		game_state_callback_ = &callback;
 	}
 
+	// moves the paddle for input that arrived after process_input(), just
+	// before rendering (see Game::late_latch_input); false if the game isn't
+	// being played, so nothing moved
+	bool late_latch_input(const InputState &input, Time dt);
+
 	void start_game()
 	{
 		switch (state_)
@@ -97,9 +107,18 @@ public:
 		}
 	}
 
+	// displayed size/position; cheap, safe to animate every frame
 	void set_size(Dimension width, Dimension height);
 	void set_position(const glm::vec2 &position);
 
+	// resolution the scene is rendered at; reallocates render targets, so only call
+	// this when the framebuffer changes size
+	void set_render_resolution(Dimension width, Dimension height);
+
+	// starts building the given levels in the background; load_level() then
+	// switches to any of them w/o touching the disk.  Call after initialize()
+	void preload_levels(const char * const *paths, size_t count);
+
 	void load_level(const char * const path);
 	void reset_level();
 	void reset();
@@ -109,6 +128,18 @@ public:
 		return lives_;
 	}
 
+	// extra balls launched w/ the player's ball at the start of every life; for
+	// stress testing & showcasing (0 for normal play)
+	static void set_extra_balls(size_t count)
+	{
+		extra_balls_ = count;
+	}
+
+	static size_t extra_balls()
+	{
+		return extra_balls_;
+	}
+
 private:
 	// Element
 	void initialize_impl(const glm::mat4 &screen_projection) override;
@@ -120,60 +151,33 @@ private:
 	// GameEndedOverlay::Handler
 	void handle_game_overlay_event_impl(Event event) override;
 
-	enum class ButtonsHandled {
-		kLeftButton = 0,
-		kRightButton,
-		kLaunchButton,
-		kNumButtons,
-		kUnknown,
-	};
-	size_t to_index(const ButtonsHandled button_id)
-	{
-		ASSERT(ButtonsHandled::kNumButtons > button_id, 
-			"Cannot convert to index (out of bounds)");
-		return static_cast<size_t>(button_id);
-	}
-	// TODO(sasiala): improve how key IDs are defined
-	ButtonsHandled convert_id(const KeyId button)
-	{
-		auto converted_id = ButtonsHandled::kUnknown;
-		switch (button)
-		{
-		case GLFW_KEY_A:
-			converted_id = ButtonsHandled::kLeftButton;
-			break;
-		case GLFW_KEY_D:
-			converted_id = ButtonsHandled::kRightButton;
-			break;
-		case GLFW_KEY_SPACE:
-			converted_id = ButtonsHandled::kLaunchButton;
-			break;
-		default:
-			LOG("Unknown button id: " + std::to_string(button));
-			break;
-		}
+	void handle_ball_box_collision(Entity ball, const Collision &collision_tuple, const size_t box_index);
+	void handle_ball_paddle_collision(Entity ball);
+	void check_collisions();
+	void find_contacts(size_t first_ball, size_t end_ball);
+	void split_balls();
+	void spawn_ball(const Transform &transform, const glm::vec2 &velocity, const BallState &state, const glm::vec3 &color);
+	void destroy_balls();
 
-		return converted_id;
+	size_t ball_count() const
+	{
+		return entities_.ball_states().size();
 	}
-	bool keys_pressed_[static_cast<size_t>(ButtonsHandled::kNumButtons)];
-	bool keys_processed_[static_cast<size_t>(ButtonsHandled::kNumButtons)];
 
-
-	void handle_ball_box_collision(const Collision &collision_tuple, const size_t box_index, const GameObject &box);
-	void activate_power_up(const PowerUp &power_up);
-	void check_collisions();
-
-	void set_key_impl(KeyId key_id, bool val) override;
+	// moves the paddle & any balls stuck to it
+	void move_paddle(float distance);
+	void handle_paddle_input(const InputState &input, Time dt);
 	void handle_left_button(float dt);
 	void handle_right_button(float dt);
 	void handle_launch_button();
-	void process_input_impl(Time dt) override;
+	void process_input_impl(const InputState &input, Time dt) override;
 
 	static constexpr struct {
 		float relative_x_;
 		float relative_y_;
 		float scale_ratio_from_height_;
 	} kLifeText{ 5.0f / 800.0f, 5.0f / 600.0f, 1.0f / 600.0f };
+	static constexpr size_t kLivesTextSize{ 24 }; // fits "Lives: " & any LifeCount
 	static constexpr LifeCount kInitialLifeCount{ 3 };
 	void reset_lives()
 	{
@@ -188,6 +192,9 @@ private:
 	void reset_player();
 	void kill_player();
 
+	// puts everything but the level's bricks back to how the level starts
+	void restart_level();
+
 	void delete_dynamic_data();
 
 	enum class PowerUpTypes : PowerUp::Type {
@@ -197,12 +204,30 @@ private:
 		kPadSizeIncrease,
 		kConfuse,
 		kChaos,
+		kMultiBall,
 		kNumTypes,
 		kUnknown,
 	};
-	bool spawn_power_ups(const GameObject &block);
-	bool is_other_power_up_active(const PowerUpTypes type);
+	static size_t to_index(const PowerUpTypes type)
+	{
+		ASSERT(type < PowerUpTypes::kNumTypes, "Invalid power-up type");
+		return static_cast<size_t>(type);
+	}
+
+	// what every power-up of a type has in common; indexed by PowerUpTypes
+	struct PowerUpKind {
+		unsigned int spawn_chance_; // spawns w/ ~1/spawn_chance_ of destroyed bricks
+		glm::vec3    color_;
+		float        duration_; // seconds the effect lasts; 0 for instant effects
+	};
+	static const PowerUpKind kPowerUpKinds[static_cast<size_t>(PowerUpTypes::kNumTypes)];
+
+	// spawns at the position of the destroyed (non-solid) brick
+	bool spawn_power_ups(const glm::vec2 &position);
+	void activate_power_up(PowerUpTypes type);
+	void deactivate_power_up(PowerUpTypes type);
 	void update_power_ups(float dt);
+	void render_power_ups();
 	
 	void level_complete();
 
@@ -237,7 +262,7 @@ private:
 	}
 
 	IResetGlProperties &gl_property_resetter_;
-	// TODO(sasiala): these are loaded width/height, not rendered width/height
+	// loaded width/height (gameplay coordinates), independent of rendered/displayed size
 	Dimension width_;
 	Dimension height_;
 
@@ -245,6 +270,7 @@ private:
 
 	GameLevel level_;
 	const char * level_path_;
+	LevelCache level_cache_;
 
 	// textures
 	static constexpr const char *kBackgroundImagePath = "textures/background.jpg";
@@ -271,16 +297,14 @@ private:
 	ResourceManager::Texture2DId ball_texture_id_;
 	ResourceManager::Texture2DId particle_texture_id_;
 
-	ResourceManager::Texture2DId pup_chaos_texture_id_;
-	ResourceManager::Texture2DId pup_confuse_texture_id_;
-	ResourceManager::Texture2DId pup_size_texture_id_;
-	ResourceManager::Texture2DId pup_pass_through_texture_id_;
-	ResourceManager::Texture2DId pup_speed_texture_id_;
-	ResourceManager::Texture2DId pup_sticky_texture_id_;
+	ResourceManager::Texture2DId power_up_texture_ids_[static_cast<size_t>(PowerUpTypes::kNumTypes)];
 
 	// shaders
 	ResourceManager::ShaderId particle_shader_id_;
 	ResourceManager::ShaderId effects_shader_id_;
+	ResourceManager::ShaderId blur_shader_id_;
+	ResourceManager::ShaderId edge_shader_id_;
+	ResourceManager::ShaderId invert_shader_id_;
 	ResourceManager::ShaderId sprite_shader_id_;
 	ResourceManager::ShaderId font_shader_id_;
 	
@@ -297,20 +321,44 @@ private:
 	// speed/size based on initial values & width/height in tutorial
 	const glm::vec2 kRelativePaddleSize = glm::vec2(100.0f / 800.0f, 20.0f / 600.0f);
 	static constexpr float kRelativePaddleVelocity{ 500.0f / 800.0f };
-	GameObject *paddle_;
 
 	const glm::vec2 kInitialBallVelocityRatio{ 100.0f / 800.0f, -350.0f / 600.0f };
 	static constexpr float kBallRadiusRatio{ 12.5f / 800.0f };
-	BallObject *ball_;
+	static constexpr size_t kMaxBalls{ 10000 };
+	static constexpr float kSplitAngle{ 0.35f }; // radians between a split ball & its copies
+	static constexpr float kExtraBallSpread{ 1.0f }; // radians the extra balls fan out over
+	static size_t extra_balls_;
+
+	// the paddle & balls; see entity_systems.h for what acts on them
+	static constexpr size_t kMaxEntities{ kMaxBalls + 1 };
+	EntityRegistry entities_;
+	Entity paddle_;
+
+	// what each ball touches this frame; found (possibly in parallel) before any are
+	// handled.  Balls rarely touch more than 4 bricks; any beyond kMaxBrickContacts
+	// are picked up the next frame
+	static constexpr size_t kMaxBrickContacts{ 8 };
+	struct BallContacts {
+		GameLevel::BrickIndex bricks_[kMaxBrickContacts];
+		size_t                brick_count_;
+		bool                  paddle_;
+	};
+	std::vector<BallContacts> ball_contacts_; // one per ball (in ball_states() order), reserved to kMaxBalls
 
 	static constexpr size_t kMaxParticles{ 500 };
 	static constexpr size_t kNewParticlesPerUpdate{ 2 };
 	ParticleGenerator *particle_generator_;
 
 	PostProcessor *effects_;
+	ResolutionController *resolution_controller_;
 	float shake_time_;
 
-	std::vector<PowerUp> power_ups_;
+	const glm::vec2 kPowerUpSize = glm::vec2(60.0f, 20.0f);
+	static constexpr float kPowerUpFallSpeed{ 150.0f };
+	PowerUpPool power_ups_; // falling power-ups
+	// seconds left of each (timed) power-up's effect, indexed by PowerUpTypes; 0 if
+	// inactive.  Picking up a power-up that's already active restarts its timer
+	float power_up_time_left_[static_cast<size_t>(PowerUpTypes::kNumTypes)];
 
 	SpriteRenderer *sprite_renderer_;
 
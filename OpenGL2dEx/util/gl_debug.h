@@ -40,7 +40,7 @@ namespace util {
 		auto error = glGetError();
 		while (error != GL_NO_ERROR)
 		{
-			LOG("OpenGL Error: " + std::string{ error_string(error) });
+			LOG_ERROR("OpenGL Error: " << error_string(error));
 			gl_error_not_found = false;
 			error = glGetError();
 		}
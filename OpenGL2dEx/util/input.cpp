@@ -0,0 +1,87 @@
+#include "input.h"
+
+#include <GLFW/glfw3.h>
+
+#include <algorithm>
+
+namespace util {
+
+constexpr size_t ActionMap::kNumKeys;
+constexpr size_t InputQueue::kCapacity;
+
+namespace {
+	struct KeyBinding {
+		KeyId       key_id_;
+		InputAction action_;
+	};
+
+	constexpr KeyBinding kDefaultBindings[]{
+		{ GLFW_KEY_W,     InputAction::kMenuUp },
+		{ GLFW_KEY_S,     InputAction::kMenuDown },
+		{ GLFW_KEY_ENTER, InputAction::kMenuAccept },
+		{ GLFW_KEY_B,     InputAction::kMenuBack },
+		{ GLFW_KEY_A,     InputAction::kPaddleLeft },
+		{ GLFW_KEY_D,     InputAction::kPaddleRight },
+		{ GLFW_KEY_SPACE, InputAction::kLaunchBall },
+		{ GLFW_KEY_M,     InputAction::kOpenMainMenu },
+		{ GLFW_KEY_L,     InputAction::kOpenLevelSelection },
+		{ GLFW_KEY_R,     InputAction::kRestartGame },
+	};
+} // namespace
+
+ActionMap::ActionMap()
+	: actions_{}
+{
+	std::fill(std::begin(actions_), std::end(actions_), InputAction::kNone);
+	for (const auto &binding : kDefaultBindings)
+	{
+		bind(binding.key_id_, binding.action_);
+	}
+}
+
+void ActionMap::bind(const KeyId key_id, const InputAction action)
+{
+	ASSERT(key_id < kNumKeys, "Key can't be bound");
+	actions_[key_id] = action;
+}
+
+void InputState::apply(const InputAction action, const bool pressed)
+{
+	const auto index = to_index(action);
+	if (pressed && !held_[index])
+	{
+		pressed_.set(index);
+	}
+	else if (!pressed && held_[index])
+	{
+		released_.set(index);
+	}
+	held_.set(index, pressed);
+}
+
+bool InputQueue::push(const InputEvent &event)
+{
+	if (size_ == kCapacity)
+	{
+		LOG_WARNING("Input queue full, dropping key " << event.key_id_);
+		return false;
+	}
+
+	events_[size_++] = event;
+	return true;
+}
+
+void InputQueue::drain(const ActionMap &action_map, InputState &state)
+{
+	for (size_t index = 0; index < size_; ++index)
+	{
+		const auto action = action_map.action(events_[index].key_id_);
+		if (action != InputAction::kNone)
+		{
+			state.apply(action, events_[index].pressed_);
+		}
+	}
+	size_ = 0;
+}
+
+} // namespace util
\ No newline at end of file
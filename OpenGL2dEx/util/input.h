@@ -0,0 +1,128 @@
+#ifndef INPUT_H
+#define INPUT_H
+
+#include "logging.h"
+#include "types.h"
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+
+namespace util {
+
+// What the game responds to, independent of the keys bound to them
+enum class InputAction : uint8_t {
+	// menus
+	kMenuUp,
+	kMenuDown,
+	kMenuAccept,
+	kMenuBack,
+	// playing
+	kPaddleLeft,
+	kPaddleRight,
+	kLaunchBall,
+	// game ended overlay
+	kOpenMainMenu,
+	kOpenLevelSelection,
+	kRestartGame,
+	kNumActions,
+	kNone,
+};
+constexpr size_t kNumInputActions{ static_cast<size_t>(InputAction::kNumActions) };
+
+// A key going down or up, as reported by the window system
+struct InputEvent {
+	KeyId  key_id_;
+	bool   pressed_; // false when released
+	double time_; // seconds, on the window system's clock
+}; // struct InputEvent
+
+// Maps keys to actions; a key maps to at most one action
+class ActionMap {
+public:
+	// keys at or past this can't be bound; GLFW's go up to 348
+	static constexpr size_t kNumKeys{ 512 };
+
+	// w/ the game's default bindings
+	ActionMap();
+
+	void bind(KeyId key_id, InputAction action);
+	// kNone for unbound keys
+	InputAction action(const KeyId key_id) const
+	{
+		return key_id < kNumKeys ? actions_[key_id] : InputAction::kNone;
+	}
+
+private:
+	InputAction actions_[kNumKeys];
+}; // class ActionMap
+
+// Which actions are held, plus which went down/up during the current tick
+// (so a tap shorter than a tick still registers as pressed)
+class InputState {
+public:
+	bool held(const InputAction action) const
+	{
+		return held_[to_index(action)];
+	}
+
+	bool pressed(const InputAction action) const
+	{
+		return pressed_[to_index(action)];
+	}
+
+	bool released(const InputAction action) const
+	{
+		return released_[to_index(action)];
+	}
+
+	// forgets the presses & releases already handled
+	void begin_tick()
+	{
+		pressed_.reset();
+		released_.reset();
+	}
+
+	void apply(InputAction action, bool pressed);
+
+private:
+	using ActionBits = std::bitset<kNumInputActions>;
+
+	static size_t to_index(const InputAction action)
+	{
+		ASSERT(action < InputAction::kNumActions, "Invalid input action");
+		return static_cast<size_t>(action);
+	}
+
+	ActionBits held_;
+	ActionBits pressed_;
+	ActionBits released_;
+}; // class InputState
+
+// Input events, in the order they happened, waiting for the next tick.  The
+// window system's callbacks push; the game drains it once per tick
+class InputQueue {
+public:
+	static constexpr size_t kCapacity{ 64 }; // events per tick
+
+	InputQueue()
+		: events_{}
+		, size_{ 0 }
+	{
+	}
+
+	// false (& the event's dropped) when the queue's full
+	bool push(const InputEvent &event);
+
+	// applies every queued event that's bound to an action, in order, &
+	// empties the queue
+	void drain(const ActionMap &action_map, InputState &state);
+
+private:
+	InputEvent events_[kCapacity];
+	size_t     size_;
+}; // class InputQueue
+
+} // namespace util
+
+#endif // INPUT_H
\ No newline at end of file
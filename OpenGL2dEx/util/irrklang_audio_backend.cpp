@@ -0,0 +1,202 @@
+#include "irrklang_audio_backend.h"
+
+#ifdef _WIN32
+
+#include "logging.h"
+
+#include <irrKlang.h>
+
+namespace util {
+
+constexpr size_t IrrKlangAudioBackend::kMaxSounds;
+constexpr size_t IrrKlangAudioBackend::kMaxVoices;
+
+IrrKlangAudioBackend::IrrKlangAudioBackend()
+	: sound_engine_{ irrklang::createIrrKlangDevice() }
+	, sounds_{}
+	, sound_settings_{}
+	, sound_count_{ 0 }
+	, voices_{}
+	, sounds_started_{ 0 }
+	, music_{ nullptr }
+{
+	// TODO(sasiala): deal with the .dll's and all for irrklang
+	if (!sound_engine_)
+	{
+		LOG_ERROR("Failed to create the irrKlang device");
+	}
+}
+
+IrrKlangAudioBackend::~IrrKlangAudioBackend()
+{
+	if (music_)
+	{
+		music_->drop();
+	}
+	music_ = nullptr;
+
+	for (auto &voice : voices_)
+	{
+		if (voice.sound_)
+		{
+			voice.sound_->stop();
+			voice.sound_->drop();
+		}
+		voice.sound_ = nullptr;
+	}
+
+	if (sound_engine_)
+	{
+		// also frees the sound sources
+		sound_engine_->drop();
+	}
+	sound_engine_ = nullptr;
+}
+
+IAudioBackend::SoundId IrrKlangAudioBackend::load_sound_impl(const char *path, const SoundSettings &settings)
+{
+	ASSERT(sound_count_ < kMaxSounds, "Too many sounds loaded");
+	ASSERT(settings.max_voices_ > 0, "A sound needs at least one voice");
+
+	const auto sound_id = static_cast<SoundId>(sound_count_++);
+	sound_settings_[sound_id] = settings;
+	// irrKlang won't add a second source for the same file, but sounds loaded
+	// from it can share the one it has
+	auto *source = sound_engine_ ? sound_engine_->getSoundSource(path, false) : nullptr;
+	if (sound_engine_ && !source)
+	{
+		source = sound_engine_->addSoundSourceFromFile(path, irrklang::ESM_AUTO_DETECT, true);
+	}
+	sounds_[sound_id] = source;
+	if (!sounds_[sound_id])
+	{
+		LOG_WARNING("Failed to load sound: " << path);
+	}
+	return sound_id;
+}
+
+void IrrKlangAudioBackend::play_sound_impl(const SoundId sound_id)
+{
+	ASSERT(sound_id < sound_count_, "Unknown sound");
+
+	if (!sounds_[sound_id])
+	{
+		return;
+	}
+
+	reclaim_voices();
+	const auto voice = choose_voice(sound_id);
+	if (!voice)
+	{
+		return;
+	}
+	if (voice->sound_)
+	{
+		voice->sound_->stop();
+		voice->sound_->drop();
+	}
+
+	// tracked, so irrKlang hands back the sound & it has to be dropped
+	auto *sound = sound_engine_->play2D(sounds_[sound_id], false, false, true);
+	*voice = Voice{ sound, sounds_started_++, sound_id };
+}
+
+void IrrKlangAudioBackend::reclaim_voices()
+{
+	for (auto &voice : voices_)
+	{
+		if (voice.sound_ && voice.sound_->isFinished())
+		{
+			voice.sound_->drop();
+			voice.sound_ = nullptr;
+		}
+	}
+}
+
+IrrKlangAudioBackend::Voice *IrrKlangAudioBackend::choose_voice(const SoundId sound_id)
+{
+	// same rules as MixerAudioBackend::choose_voice: at its own limit, a sound
+	// restarts its oldest copy; when every voice is busy, the lowest priority
+	// sound is cut off unless everything playing matters more
+	size_t playing = 0;
+	Voice *oldest_copy = nullptr;
+	Voice *free_voice = nullptr;
+	for (auto &voice : voices_)
+	{
+		if (!voice.sound_)
+		{
+			free_voice = free_voice ? free_voice : &voice;
+		}
+		else if (voice.sound_id_ == sound_id)
+		{
+			++playing;
+			if (!oldest_copy || voice.started_ < oldest_copy->started_)
+			{
+				oldest_copy = &voice;
+			}
+		}
+	}
+	if (playing >= sound_settings_[sound_id].max_voices_)
+	{
+		return oldest_copy;
+	}
+	if (free_voice)
+	{
+		return free_voice;
+	}
+
+	Voice *victim = nullptr;
+	for (auto &voice : voices_)
+	{
+		const auto priority = sound_settings_[voice.sound_id_].priority_;
+		if (!victim || priority < sound_settings_[victim->sound_id_].priority_ ||
+			(priority == sound_settings_[victim->sound_id_].priority_ && voice.started_ < victim->started_))
+		{
+			victim = &voice;
+		}
+	}
+	if (sound_settings_[victim->sound_id_].priority_ > sound_settings_[sound_id].priority_)
+	{
+		LOG_DEBUG("All voices busy w/ higher priority sounds, dropping sound " << sound_id);
+		return nullptr;
+	}
+	return victim;
+}
+
+void IrrKlangAudioBackend::play_music_impl(const char *path, const bool loop)
+{
+	if (!sound_engine_)
+	{
+		return;
+	}
+
+	// irrKlang streams long files itself
+	// the old track is cut rather than crossfaded, as irrKlang has no fades of its own
+	if (music_)
+	{
+		music_->stop();
+		music_->drop();
+	}
+	music_ = sound_engine_->play2D(path, loop, false, true);
+	if (!music_)
+	{
+		LOG_WARNING("Failed to play music: " << path);
+	}
+}
+
+void IrrKlangAudioBackend::set_volume_impl(const Volume volume)
+{
+	if (sound_engine_)
+	{
+		sound_engine_->setSoundVolume(volume);
+	}
+}
+
+IAudioBackend::Volume IrrKlangAudioBackend::volume_impl() const
+{
+	return sound_engine_ ? sound_engine_->getSoundVolume() : 0.0f;
+}
+
+} // namespace util
+
+#endif // _WIN32
\ No newline at end of file
@@ -0,0 +1,67 @@
+#ifndef IRRKLANG_AUDIO_BACKEND_H
+#define IRRKLANG_AUDIO_BACKEND_H
+
+// irrKlang is only available as Windows binaries (see libs/irrklang)
+#ifdef _WIN32
+
+#include "audio_backend.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace irrklang {
+class ISound;
+class ISoundEngine;
+class ISoundSource;
+} // namespace irrklang
+
+namespace util {
+
+// Plays through irrKlang's output device.  Sounds are preloaded as irrKlang
+// sound sources, so playing one doesn't go back to the file.  irrKlang mixes
+// the voices itself; this keeps a handle on each one so the voice limits &
+// priorities in SoundSettings work as they do in MixerAudioBackend
+class IrrKlangAudioBackend : public IAudioBackend {
+public:
+	IrrKlangAudioBackend();
+	~IrrKlangAudioBackend() override;
+
+	IrrKlangAudioBackend(const IrrKlangAudioBackend&) = delete;
+	IrrKlangAudioBackend &operator=(const IrrKlangAudioBackend&) = delete;
+
+	static constexpr size_t kMaxSounds{ 16 };
+	static constexpr size_t kMaxVoices{ 32 }; // sounds playing at once
+
+private:
+	struct Voice {
+		irrklang::ISound *sound_; // null when the voice is free
+		uint64_t          started_; // when play_sound started it; lower is older
+		SoundId           sound_id_;
+	};
+
+	SoundId load_sound_impl(const char *path, const SoundSettings &settings) override;
+	void play_sound_impl(SoundId sound_id) override;
+	void play_music_impl(const char *path, bool loop) override;
+	void set_volume_impl(Volume volume) override;
+	Volume volume_impl() const override;
+
+	// frees the voices whose sound has finished
+	void reclaim_voices();
+	// the voice to play sound_id on, stopping what's on it if need be; null
+	// drops the sound
+	Voice *choose_voice(SoundId sound_id);
+
+	irrklang::ISoundEngine *sound_engine_;
+	irrklang::ISoundSource *sounds_[kMaxSounds]; // null if the sound failed to load
+	SoundSettings           sound_settings_[kMaxSounds];
+	size_t                  sound_count_;
+	Voice                   voices_[kMaxVoices];
+	uint64_t                sounds_started_;
+	irrklang::ISound       *music_; // the track playing, if any
+}; // class IrrKlangAudioBackend
+
+} // namespace util
+
+#endif // _WIN32
+
+#endif // IRRKLANG_AUDIO_BACKEND_H
\ No newline at end of file
@@ -10,7 +10,7 @@
 namespace util {
 
 template<size_t MAX_STRING_LENGTH>
-class Label : public Element {
+class Label final : public Element {
 public:
 	static constexpr auto kMaxStringLength = MAX_STRING_LENGTH;
 	using StringType = string<kMaxStringLength>;
@@ -47,41 +47,43 @@ public:
 	{
 	}
 
+	// setters only mark the label dirty when the value changes; menus re-apply
+	// highlights every frame
 	void set_font(const ResourceManager::FontId font_id)
 	{
-		font_id_ = font_id;
+		set(font_id_, font_id);
 	}
 
 	void set_x_ratio(const float x_ratio)
 	{
-		x_ratio_ = x_ratio;
+		set(x_ratio_, x_ratio);
 	}
 
 	void set_y_ratio(const float y_ratio)
 	{
-		y_ratio_ = y_ratio;
+		set(y_ratio_, y_ratio);
 	}
 
 	void set_scale_ratio(const float scale_ratio)
 	{
-		scale_ratio_ = scale_ratio;
+		set(scale_ratio_, scale_ratio);
 	}
 
 	void set_color(const glm::vec3 &color)
 	{
-		color_ = color;
+		set(color_, color);
 	}
 
 	void set_text(const StringType &text)
 	{
-		text_ = text;
+		set(text_, text);
 	}
 
 	void set_viewport_size(const Dimension viewport_width, 
 		                   const Dimension viewport_height)
 	{
-		viewport_width_ = viewport_width;
-		viewport_height_ = viewport_height;
+		set(viewport_width_, viewport_width);
+		set(viewport_height_, viewport_height);
 	}
 
 	static constexpr size_t max_size()
@@ -90,6 +92,8 @@ public:
 	}
 
 private:
+	friend class Element; // for the *_final calls
+
 	// Element
 	void initialize_impl(const glm::mat4 &/*projection*/) override
 	{
@@ -114,11 +118,29 @@ private:
 		text_renderer.update_size(viewport_width_, viewport_height_);
 		text_renderer.render_text(text_.c_str(), x(viewport_width_), y(viewport_height_), scale(viewport_height_), color_);
 	}
-	void set_key_impl(KeyId /*key_id*/, bool /*val*/) override
+	void process_input_impl(const InputState& /*input*/, float /*dt*/) override
 	{
 	}
-	void process_input_impl(float /*dt*/) override
+
+	template <typename Value>
+	void set(Value &member, const Value &value)
 	{
+		if (member != value)
+		{
+			member = value;
+			mark_dirty();
+		}
+	}
+
+	// text_ keeps its hash (it's copied in w/ the text), so only the new
+	// text's is computed; when they differ, the text isn't compared at all
+	void set(StringType &member, const StringType &value)
+	{
+		if (member.hash() != value.hash() || member != value)
+		{
+			member = value;
+			mark_dirty();
+		}
 	}
 
 	float x(const Dimension width) const
@@ -0,0 +1,57 @@
+#include "latency_probe.h"
+
+#include "logging.h"
+
+namespace util {
+
+bool                  LatencyProbe::enabled_{ false };
+LatencyProbe::State   LatencyProbe::state_{ State::kIdle };
+LatencyProbe::Seconds LatencyProbe::key_press_time_{ 0.0 };
+LatencyProbe::Seconds LatencyProbe::submit_time_{ 0.0 };
+
+void LatencyProbe::record_key_press(const Seconds time)
+{
+	// presses during a measurement are ignored, so each flash matches one press
+	if (!enabled_ || state_ != State::kIdle)
+	{
+		return;
+	}
+
+	key_press_time_ = time;
+	state_ = State::kKeyPressed;
+}
+
+bool LatencyProbe::begin_frame()
+{
+	if (!enabled_ || state_ != State::kKeyPressed)
+	{
+		return false;
+	}
+
+	state_ = State::kFlashing;
+	return true;
+}
+
+void LatencyProbe::frame_submitted(const Seconds time)
+{
+	if (state_ == State::kFlashing)
+	{
+		submit_time_ = time;
+	}
+}
+
+void LatencyProbe::frame_presented(const Seconds time)
+{
+	if (state_ != State::kFlashing)
+	{
+		return;
+	}
+
+	constexpr double kMillisecondsPerSecond{ 1000.0 };
+	LOG("Input latency: key press at " << key_press_time_ << "s, "
+		<< (submit_time_ - key_press_time_) * kMillisecondsPerSecond << "ms to submit, "
+		<< (time - key_press_time_) * kMillisecondsPerSecond << "ms to present");
+	state_ = State::kIdle;
+}
+
+} // namespace util
\ No newline at end of file
@@ -0,0 +1,56 @@
+#ifndef LATENCY_PROBE_H
+#define LATENCY_PROBE_H
+
+namespace util {
+
+// Input-to-photon latency measurement.  The first key pressed after each
+// measurement turns the next frame into a test pattern (a white flash), which
+// a camera or photodiode on the screen can time from the key press; the probe
+// logs the part of that latency the game controls, from the key event to the
+// frame's submission & to the buffer swap completing.  Waits on the GPU after
+// every swap, so it's for measuring only
+class LatencyProbe {
+public:
+	using Seconds = double; // on the window system's clock
+
+	static void set_enabled(const bool enabled)
+	{
+		enabled_ = enabled;
+	}
+
+	static bool enabled()
+	{
+		return enabled_;
+	}
+
+	// from the key callback
+	static void record_key_press(Seconds time);
+
+	// true if the frame about to be rendered should be the flash
+	static bool begin_frame();
+	// after the frame's draw calls are issued
+	static void frame_submitted(Seconds time);
+	// once the swap's done & the GPU's finished the frame; logs the measurement
+	static void frame_presented(Seconds time);
+
+private:
+	// singleton
+	LatencyProbe()
+	{
+	}
+
+	enum class State {
+		kIdle,
+		kKeyPressed, // waiting for the next frame
+		kFlashing, // the flash frame's being rendered & presented
+	};
+
+	static bool    enabled_;
+	static State   state_;
+	static Seconds key_press_time_;
+	static Seconds submit_time_;
+}; // class LatencyProbe
+
+} // namespace util
+
+#endif // LATENCY_PROBE_H
\ No newline at end of file
@@ -0,0 +1,76 @@
+#include "level_cache.h"
+
+#include "logging.h"
+
+namespace util {
+
+	LevelCache::LevelCache()
+		: entries_{}
+		, entry_indices_{}
+		, worker_{}
+		, mutex_{}
+		, entry_ready_{}
+	{
+	}
+
+	LevelCache::~LevelCache()
+	{
+		if (worker_.joinable())
+		{
+			worker_.join();
+		}
+	}
+
+	void LevelCache::preload(const char * const *paths,
+							 const size_t       count,
+							 const unsigned int level_width,
+							 const unsigned int level_height)
+	{
+		ASSERT(!worker_.joinable() && entries_.empty(), "Levels already preloaded");
+
+		entries_.resize(count);
+		entry_indices_.reserve(count);
+		for (size_t i = 0; i < count; ++i)
+		{
+			entries_[i].path_ = paths[i];
+			entries_[i].ready_ = false;
+			entries_[i].valid_ = false;
+			entry_indices_.emplace(paths[i], i);
+		}
+
+		worker_ = std::thread{ &LevelCache::load_all, this, level_width, level_height };
+	}
+
+	const LevelTemplate *LevelCache::get(const char *path)
+	{
+		const auto found = entry_indices_.find(path);
+		if (found == entry_indices_.end())
+		{
+			return nullptr;
+		}
+
+		auto &entry = entries_[found->second];
+		std::unique_lock<std::mutex> lock{ mutex_ };
+		entry_ready_.wait(lock, [&entry]() { return entry.ready_; });
+		return entry.valid_ ? &entry.level_ : nullptr;
+	}
+
+	void LevelCache::load_all(const unsigned int level_width,
+							  const unsigned int level_height)
+	{
+		// levels are built in order, so the first (usually the one shown first) is ready first.
+		// An entry's level_ is only written before it's marked ready, & only read after
+		for (auto &entry : entries_)
+		{
+			const auto valid = entry.level_.load(entry.path_, level_width, level_height);
+
+			{
+				std::lock_guard<std::mutex> lock{ mutex_ };
+				entry.valid_ = valid;
+				entry.ready_ = true;
+			}
+			entry_ready_.notify_all();
+		}
+	}
+
+} // namespace util
\ No newline at end of file
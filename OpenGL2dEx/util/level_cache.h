@@ -0,0 +1,59 @@
+#ifndef LEVEL_CACHE_H
+#define LEVEL_CACHE_H
+
+#include "level_template.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace util {
+
+// Parses & builds a set of levels on a background thread so that switching
+// between them (e.g. while scrolling the level selection) is a lookup rather
+// than a load from disk.  Levels are looked up in O(1) by the path pointers
+// given to preload() (e.g. Game::kLevelPaths), which must outlive the cache;
+// an equal string at a different address is treated as not preloaded.
+class LevelCache {
+public:
+	LevelCache();
+	~LevelCache();
+
+	LevelCache(const LevelCache&) = delete;
+	LevelCache &operator=(const LevelCache&) = delete;
+
+	// may only be called once; returns immediately
+	void preload(const char * const *paths,
+				 size_t             count,
+				 unsigned int       level_width,
+				 unsigned int       level_height);
+
+	// nullptr if path isn't one of the preloaded pointers or failed to load; waits
+	// for the worker if the level hasn't been built yet
+	const LevelTemplate *get(const char *path);
+
+private:
+	struct Entry {
+		const char    *path_;
+		LevelTemplate level_;
+		bool          ready_;
+		bool          valid_;
+	};
+
+	void load_all(unsigned int level_width,
+				  unsigned int level_height);
+
+	// sized once in preload(), before the worker starts, so entries never move
+	std::vector<Entry>                      entries_;
+	std::unordered_map<const char*, size_t> entry_indices_; // keyed by address, so a lookup doesn't copy the path
+
+	std::thread             worker_;
+	std::mutex              mutex_;
+	std::condition_variable entry_ready_;
+}; // class LevelCache
+
+} // namespace util
+
+#endif // LEVEL_CACHE_H
\ No newline at end of file
@@ -0,0 +1,200 @@
+#include "level_format.h"
+
+#include "logging.h"
+#include "mapped_file.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace util {
+
+namespace {
+	constexpr char kBinaryMagic[4] = { 'B', 'L', 'V', 'L' };
+
+	uint16_t read_u16(const unsigned char *data)
+	{
+		return static_cast<uint16_t>(data[0] | (data[1] << 8));
+	}
+
+	uint32_t read_u32(const unsigned char *data)
+	{
+		return static_cast<uint32_t>(data[0])
+			| (static_cast<uint32_t>(data[1]) << 8)
+			| (static_cast<uint32_t>(data[2]) << 16)
+			| (static_cast<uint32_t>(data[3]) << 24);
+	}
+
+	void write_u16(unsigned char *data, const uint16_t value)
+	{
+		data[0] = static_cast<unsigned char>(value & 0xFF);
+		data[1] = static_cast<unsigned char>((value >> 8) & 0xFF);
+	}
+
+	void write_u32(unsigned char *data, const uint32_t value)
+	{
+		for (auto i = 0; i < 4; ++i)
+		{
+			data[i] = static_cast<unsigned char>((value >> (8 * i)) & 0xFF);
+		}
+	}
+} // namespace
+
+	constexpr size_t LevelFormat::kBinaryHeaderSize;
+	constexpr uint16_t LevelFormat::kBinaryVersion;
+	constexpr uint16_t LevelFormat::kFlagHasMetadata;
+	constexpr LevelFormat::Tile LevelFormat::kMaxTileCode;
+
+	bool LevelFormat::is_binary(const unsigned char *data, const size_t size)
+	{
+		return size >= sizeof(kBinaryMagic) && std::memcmp(data, kBinaryMagic, sizeof(kBinaryMagic)) == 0;
+	}
+
+	bool LevelFormat::parse_binary(const unsigned char *data, const size_t size, LevelGrid &grid)
+	{
+		if (size < kBinaryHeaderSize || !is_binary(data, size))
+		{
+			LOG("Not a binary level");
+			return false;
+		}
+
+		const auto version = read_u16(data + 4);
+		if (version != kBinaryVersion)
+		{
+			LOG("Unsupported binary level version: " << version);
+			return false;
+		}
+
+		const auto flags = read_u16(data + 6);
+		const auto width = read_u32(data + 8);
+		const auto height = read_u32(data + 12);
+		const auto tile_count = static_cast<uint64_t>(width) * height;
+		const auto has_metadata = (flags & kFlagHasMetadata) != 0;
+		const auto required_size = kBinaryHeaderSize + tile_count * (has_metadata ? 2 : 1);
+		if (tile_count == 0 || required_size > size)
+		{
+			LOG("Truncated binary level (" << size << " bytes, expected " << required_size << ")");
+			return false;
+		}
+
+		const auto *tiles = data + kBinaryHeaderSize;
+		const auto *tiles_end = tiles + tile_count;
+		const auto *invalid_tile = std::find_if(tiles, tiles_end, [](const Tile tile) { return tile > kMaxTileCode; });
+		if (invalid_tile != tiles_end)
+		{
+			LOG("Tile code " << static_cast<unsigned int>(*invalid_tile) << " out of range at tile " << (invalid_tile - tiles));
+			return false;
+		}
+
+		grid = { width, height, tiles, has_metadata ? tiles + tile_count : nullptr };
+		return true;
+	}
+
+	bool LevelFormat::parse_text(const char *data, const size_t size, std::vector<Tile> &tile_storage, LevelGrid &grid)
+	{
+		// every tile but the last takes at least 2 characters, so this bounds the tile
+		// count; reserving it up front keeps this to a single allocation
+		tile_storage.clear();
+		tile_storage.reserve(size / 2 + 1);
+
+		uint32_t width{ 0 };
+		uint32_t height{ 0 };
+		uint32_t row_width{ 0 };
+		unsigned int value{ 0 };
+		auto in_number = false;
+
+		// one past the end acts as a final newline, in case the file doesn't end w/ one
+		for (size_t i = 0; i <= size; ++i)
+		{
+			const auto c = (i < size) ? data[i] : '\n';
+			if (c >= '0' && c <= '9')
+			{
+				value = value * 10 + static_cast<unsigned int>(c - '0');
+				if (value > kMaxTileCode)
+				{
+					LOG("Tile code out of range in row " << height);
+					return false;
+				}
+				in_number = true;
+				continue;
+			}
+
+			if (in_number)
+			{
+				tile_storage.push_back(static_cast<Tile>(value));
+				++row_width;
+				value = 0;
+				in_number = false;
+			}
+
+			if (c == '\n')
+			{
+				// blank lines don't count as rows
+				if (row_width > 0)
+				{
+					if (height == 0)
+					{
+						width = row_width;
+					}
+					else if (row_width != width)
+					{
+						LOG("Row " << height << " has " << row_width << " tiles, expected " << width);
+						return false;
+					}
+					++height;
+					row_width = 0;
+				}
+			}
+			else if (c != ' ' && c != '\t' && c != '\r')
+			{
+				LOG("Unexpected character in level: " << c);
+				return false;
+			}
+		}
+
+		if (height == 0)
+		{
+			return false;
+		}
+
+		grid = { width, height, tile_storage.data(), nullptr };
+		return true;
+	}
+
+	bool LevelFormat::compile(const char *text_path, const char *binary_path)
+	{
+		MappedFile text_file{ text_path };
+		if (!text_file.is_open())
+		{
+			return false;
+		}
+
+		std::vector<Tile> tiles{};
+		LevelGrid grid{};
+		if (!parse_text(reinterpret_cast<const char*>(text_file.data()), text_file.size(), tiles, grid))
+		{
+			LOG("Failed to parse level: " << text_path);
+			return false;
+		}
+
+		unsigned char header[kBinaryHeaderSize]{};
+		std::memcpy(header, kBinaryMagic, sizeof(kBinaryMagic));
+		write_u16(header + 4, kBinaryVersion);
+		write_u16(header + 6, 0);
+		write_u32(header + 8, grid.width_);
+		write_u32(header + 12, grid.height_);
+
+		std::ofstream binary_file{ binary_path, std::ios::binary | std::ios::trunc };
+		binary_file.write(reinterpret_cast<const char*>(header), sizeof(header));
+		binary_file.write(reinterpret_cast<const char*>(grid.tiles_), static_cast<std::streamsize>(tiles.size()));
+		if (!binary_file)
+		{
+			LOG("Failed to write binary level: " << binary_path);
+			return false;
+		}
+
+		LOG("Compiled " << text_path << " (" << grid.width_ << "x" << grid.height_ << ") to " << binary_path);
+		return true;
+	}
+
+} // namespace util
\ No newline at end of file
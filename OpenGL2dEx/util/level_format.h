@@ -0,0 +1,62 @@
+#ifndef LEVEL_FORMAT_H
+#define LEVEL_FORMAT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace util {
+
+// Tile grid of a level.  tiles_/metadata_ point into storage owned by whoever
+// parsed the level (a MappedFile for binary levels, a vector for text levels)
+struct LevelGrid {
+	uint32_t       width_;
+	uint32_t       height_;
+	const uint8_t *tiles_;    // width_ * height_ tile codes, row-major
+	const uint8_t *metadata_; // width_ * height_ bytes of per-tile metadata, or nullptr
+}; // struct LevelGrid
+
+// Readers/writers for the two level file formats:
+//
+// text (.lvl): one row of whitespace-separated tile codes per line
+//
+// binary (.blvl), all fields little-endian:
+//   offset  size  field
+//   0       4     magic "BLVL"
+//   4       2     version (kBinaryVersion)
+//   6       2     flags (kFlagHasMetadata)
+//   8       4     width in tiles
+//   12      4     height in tiles
+//   16      w*h   tile codes, row-major
+//   16+w*h  w*h   per-tile metadata (only if kFlagHasMetadata)
+class LevelFormat {
+public:
+	using Tile = uint8_t;
+
+	static constexpr size_t   kBinaryHeaderSize{ 16 };
+	static constexpr uint16_t kBinaryVersion{ 1 };
+	static constexpr uint16_t kFlagHasMetadata{ 1 << 0 };
+	// highest tile code a level may use; see TileColor in level_template.cpp
+	static constexpr Tile     kMaxTileCode{ 5 };
+
+	static bool is_binary(const unsigned char *data, size_t size);
+
+	// grid points into data, which must outlive it; fails on tile codes above kMaxTileCode
+	static bool parse_binary(const unsigned char *data, size_t size, LevelGrid &grid);
+
+	// tiles are appended to tile_storage (a single allocation), which grid then points into
+	static bool parse_text(const char *data, size_t size, std::vector<Tile> &tile_storage, LevelGrid &grid);
+
+	// offline conversion of a text level into the binary format
+	static bool compile(const char *text_path, const char *binary_path);
+
+private:
+	// singleton
+	LevelFormat()
+	{
+	}
+}; // class LevelFormat
+
+} // namespace util
+
+#endif // LEVEL_FORMAT_H
\ No newline at end of file
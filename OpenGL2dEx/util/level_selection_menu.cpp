@@ -71,23 +71,23 @@ namespace {
 		menu_options_.render(parent_sprite_renderer);
 	}
 
-	void LevelSelectionMenu::set_key_impl(KeyId key_id, bool val)
+	void LevelSelectionMenu::process_input_impl(const InputState &input, Time dt)
 	{
 		if (!is_active())
 		{
 			return;
 		}
+		menu_options_.process_input(input, dt);
+	}
 
-		menu_options_.set_key(key_id, val);
+	bool LevelSelectionMenu::is_dirty_impl() const
+	{
+		return menu_options_.is_dirty();
 	}
 
-	void LevelSelectionMenu::process_input_impl(Time dt)
+	void LevelSelectionMenu::clear_dirty_impl()
 	{
-		if (!is_active())
-		{
-			return;
-		}
-		menu_options_.process_input(dt);
+		menu_options_.clear_dirty();
 	}
 
 	void LevelSelectionMenu::handle_menu_option_highlight_impl(const MenuIndex index)
@@ -116,23 +116,20 @@ namespace {
 		element.get<LabelType>().set_color(kDeselectedTextColor);
 	}
 
-	std::pair<LevelSelectionMenu::MenuIndex, LevelSelectionMenu::MenuList> LevelSelectionMenu::menu_list(
+	void LevelSelectionMenu::add_menu_options(
+		MenuList        &menu_list,
 		const LevelList &level_list, 
-		const Dimension load_width, 
-		const Dimension load_height)
+		const Dimension  load_width, 
+		const Dimension  load_height)
 	{
-		auto menu_list_pair = std::make_pair<MenuIndex, MenuList>({0}, {});
 		for (auto i = size_t{ 0 }; i < MenuList::kMaxObjects; ++i)
 		{
 			const auto str = level_list[i];
 			if (strcmp(str, "") == 0)
 				break;
 
-			++menu_list_pair.first;
-			menu_list_pair.second.push_back(menu_list_object(level_list[i], i, load_width, load_height));
+			menu_list.emplace_back(menu_list_object(level_list[i], i, load_width, load_height));
 		}
-
-		return menu_list_pair;
 	}
 
 } // namespace util
\ No newline at end of file
@@ -96,9 +96,11 @@ public:
 
 	void update_levels(const LevelList &levels, const MenuIndex current_level)
 	{
-		const auto menu_list_pair = menu_list(levels, load_width_, load_height_);
-		ASSERT(current_level < menu_list_pair.first, "Current level not found in list");
-		menu_options_.update_info("MAIN MENU", kSubtitle, true, menu_list_pair.second, current_level);
+		const auto load_width = load_width_;
+		const auto load_height = load_height_;
+		menu_options_.update_info("MAIN MENU", kSubtitle, true, [&levels, load_width, load_height](MenuList &menu_list) {
+			add_menu_options(menu_list, levels, load_width, load_height);
+		}, current_level);
 		current_level_ = current_level;
 	}
 
@@ -109,9 +111,9 @@ private:
 	void activate_impl() override;
 	void deactivate_impl() override;
 	void render_impl(Optional<SpriteRenderer*> parent_sprite_renderer) override;
-	void set_key_impl(KeyId key_id, bool val) override;
-	// TODO(sasiala): improve event handling
-	void process_input_impl(Time dt) override;
+	void process_input_impl(const InputState &input, Time dt) override;
+	bool is_dirty_impl() const override;
+	void clear_dirty_impl() override;
 
 	// Menu::MenuButtonHandler
 	void handle_menu_option_highlight_impl(MenuIndex index) override;
@@ -120,7 +122,7 @@ private:
 	void apply_highlight_impl(MenuType::ElementType &element) override;
 	void remove_highlight_impl(MenuType::ElementType &element) override;
 
-	static std::pair<MenuIndex, MenuList> menu_list(const LevelList &level_list, Dimension load_width, Dimension load_height);
+	static void add_menu_options(MenuList &menu_list, const LevelList &level_list, Dimension load_width, Dimension load_height);
 
 	Dimension load_width_;
 	Dimension load_height_;
@@ -0,0 +1,136 @@
+#include "level_template.h"
+
+#include "logging.h"
+#include "mapped_file.h"
+
+#include <algorithm>
+#include <string>
+
+namespace util {
+
+namespace {
+	enum class TileColor : LevelTemplate::ColorIndex {
+		kUnknown = 0,
+		kSolid = 1,
+		kTwo = 2,
+		kThree = 3,
+		kFour = 4,
+		kFive = 5,
+		kNumColors,
+	};
+
+	// indexed by TileColor, which matches the tile code of the level file
+	// TODO(sasiala): better way to do colors
+	const glm::vec3 kTileColors[] = {
+		glm::vec3(1.0f),
+		glm::vec3(0.8f, 0.8f, 0.7f),
+		glm::vec3(0.2f, 0.6f, 1.0f),
+		glm::vec3(0.0f, 0.7f, 0.0f),
+		glm::vec3(0.8f, 0.8f, 0.4f),
+		glm::vec3(1.0f, 0.5f, 0.0f),
+	};
+	static_assert(sizeof(kTileColors) / sizeof(kTileColors[0]) == static_cast<size_t>(TileColor::kNumColors),
+		"Every tile color needs a palette entry");
+	static_assert(static_cast<size_t>(TileColor::kNumColors) == LevelFormat::kMaxTileCode + 1u,
+		"Every valid tile code needs a color");
+} // namespace
+
+bool LevelTemplate::load(const char   *file,
+						 unsigned int level_width,
+						 unsigned int level_height)
+{
+	x_.clear();
+	y_.clear();
+	color_indices_.clear();
+	solid_.clear();
+	brick_size_ = glm::vec2{ 0.0f };
+	destructible_bricks_ = 0;
+	grid_columns_ = 0;
+	grid_rows_ = 0;
+	cell_offsets_.clear();
+
+	const MappedFile level_file{ file };
+	if (!level_file.is_open())
+	{
+		return false;
+	}
+
+	// binary levels are used in place; text levels are parsed into a single buffer
+	std::vector<LevelFormat::Tile> text_tiles{};
+	LevelGrid grid{};
+	const auto parsed = LevelFormat::is_binary(level_file.data(), level_file.size())
+		? LevelFormat::parse_binary(level_file.data(), level_file.size(), grid)
+		: LevelFormat::parse_text(reinterpret_cast<const char*>(level_file.data()), level_file.size(), text_tiles, grid);
+
+	if (!parsed)
+	{
+		LOG("Failed to parse level: " << file);
+		return false;
+	}
+
+	build(grid, level_width, level_height);
+	return true;
+}
+
+const glm::vec3 &LevelTemplate::color(const size_t index) const
+{
+	return kTileColors[color_indices_[index]];
+}
+
+void LevelTemplate::build(const LevelGrid &grid,
+						  unsigned int    level_width,
+						  unsigned int    level_height)
+{
+	ASSERT(grid.width_ > 0 && grid.height_ > 0, "No tile data");
+	// calculate dimensions
+	const unsigned int height = grid.height_;
+	const unsigned int width = grid.width_;
+	float unit_width = level_width / static_cast<float>(width);
+	float unit_height = level_height / static_cast<float>(height);
+	brick_size_ = glm::vec2{ unit_width, unit_height };
+
+	// size the arrays once rather than growing them brick by brick
+	const auto tile_count = static_cast<size_t>(width) * height;
+	const auto brick_count = tile_count - std::count(grid.tiles_, grid.tiles_ + tile_count, LevelFormat::Tile{ 0 });
+	x_.reserve(brick_count);
+	y_.reserve(brick_count);
+	color_indices_.reserve(brick_count);
+	solid_.reserve(brick_count);
+	grid_columns_ = width;
+	grid_rows_ = height;
+	cell_offsets_.resize(tile_count + 1);
+
+	for (unsigned int y = 0; y < height; ++y)
+	{
+		for (unsigned int x = 0; x < width; ++x)
+		{
+			const auto cell = static_cast<size_t>(y) * width + x;
+			cell_offsets_[cell] = static_cast<BrickIndex>(x_.size());
+			const unsigned int current_val = grid.tiles_[cell];
+			if (current_val == 0)
+			{
+				continue;
+			}
+
+			auto color = static_cast<ColorIndex>(current_val);
+			if (current_val >= static_cast<unsigned int>(TileColor::kNumColors))
+			{
+				ASSERT(false, "Unknown tile value: " + std::to_string(current_val));
+				color = static_cast<ColorIndex>(TileColor::kUnknown);
+			}
+
+			const auto solid = (current_val == static_cast<unsigned int>(TileColor::kSolid));
+			x_.push_back(unit_width * x);
+			y_.push_back(unit_height * y);
+			color_indices_.push_back(color);
+			solid_.push_back(solid ? 1 : 0);
+			if (!solid)
+			{
+				++destructible_bricks_;
+			}
+		}
+	}
+	cell_offsets_[tile_count] = static_cast<BrickIndex>(x_.size());
+}
+
+} // namespace util
\ No newline at end of file
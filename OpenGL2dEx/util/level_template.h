@@ -0,0 +1,118 @@
+#ifndef LEVEL_TEMPLATE_H
+#define LEVEL_TEMPLATE_H
+
+#include "level_format.h"
+#include "logging.h"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace util {
+
+// The immutable part of a level: its bricks as built from the level file.
+// Bricks are stored as parallel arrays (one entry per brick, row-major order)
+// so loops only touch the fields they need; e.g. the collision scan reads
+// nothing but x_/y_.  Every brick of a level has the same size & sits in a cell
+// of the level's grid, which is what the collision broad phase works with.
+// Nothing in here touches OpenGL or the ResourceManager, so templates can be
+// built off the main thread (see LevelCache)
+class LevelTemplate {
+public:
+	using ColorIndex = uint8_t;
+	using BrickIndex = uint32_t;
+
+	LevelTemplate()
+		: x_{}
+		, y_{}
+		, color_indices_{}
+		, solid_{}
+		, brick_size_{ 0.0f }
+		, destructible_bricks_{ 0 }
+		, grid_columns_{ 0 }
+		, grid_rows_{ 0 }
+		, cell_offsets_{}
+	{
+	}
+
+	// replaces the bricks w/ those of the given level file (text or binary); on
+	// failure the template is left empty
+	bool load(const char   *file,
+			  unsigned int level_width,
+			  unsigned int level_height);
+
+	size_t brick_count() const
+	{
+		return x_.size();
+	}
+
+	const float *x() const
+	{
+		return x_.data();
+	}
+
+	const float *y() const
+	{
+		return y_.data();
+	}
+
+	glm::vec2 position(const size_t index) const
+	{
+		return{ x_[index], y_[index] };
+	}
+
+	const glm::vec2 &brick_size() const
+	{
+		return brick_size_;
+	}
+
+	bool is_solid(const size_t index) const
+	{
+		return solid_[index] != 0;
+	}
+
+	const glm::vec3 &color(const size_t index) const;
+
+	size_t destructible_bricks() const
+	{
+		return destructible_bricks_;
+	}
+
+	size_t grid_columns() const
+	{
+		return grid_columns_;
+	}
+
+	size_t grid_rows() const
+	{
+		return grid_rows_;
+	}
+
+	// number of bricks in the cells before the given (row-major) cell index, so the
+	// bricks in cells [a, b) are exactly those w/ indices [bricks_before(a), bricks_before(b))
+	BrickIndex bricks_before(const size_t cell) const
+	{
+		ASSERT(cell < cell_offsets_.size(), "Cell index out of bounds");
+		return cell_offsets_[cell];
+	}
+
+private:
+	void build(const LevelGrid &grid,
+			   unsigned int    level_width,
+			   unsigned int    level_height);
+
+	std::vector<float>      x_;
+	std::vector<float>      y_;
+	std::vector<ColorIndex> color_indices_; // index into the color palette (see .cpp)
+	std::vector<uint8_t>    solid_; // bytes rather than bits so scans stay branch-free
+	glm::vec2               brick_size_;
+	size_t                  destructible_bricks_;
+	size_t                  grid_columns_;
+	size_t                  grid_rows_;
+	std::vector<BrickIndex> cell_offsets_; // one per cell + 1; see bricks_before()
+}; // class LevelTemplate
+
+} // namespace util
+
+#endif // LEVEL_TEMPLATE_H
\ No newline at end of file
@@ -0,0 +1,343 @@
+#include "logger.h"
+#include "logging.h"
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+
+namespace util {
+
+constexpr size_t LogRecord::kPayloadSize;
+constexpr size_t Logger::kCapacity;
+constexpr size_t Logger::kMask;
+
+namespace {
+	// how long the writer sleeps when there's nothing to write; records wait at
+	// most about this long before reaching the log
+	constexpr std::chrono::milliseconds kIdleSleep{ 5 };
+
+	const char *level_prefix(const LogLevel level)
+	{
+		switch (level)
+		{
+		case LogLevel::kDebug:
+			return "debug: ";
+		case LogLevel::kWarning:
+			return "warning: ";
+		case LogLevel::kError:
+			return "error: ";
+		default:
+			return "";
+		}
+	}
+} // namespace
+
+LogRecord &LogRecord::operator<<(const char *text)
+{
+	append_text(text, text ? std::strlen(text) : 0);
+	return *this;
+}
+
+LogRecord &LogRecord::operator<<(const std::string &text)
+{
+	append_text(text.c_str(), text.size());
+	return *this;
+}
+
+LogRecord &LogRecord::operator<<(const char value)
+{
+	append(Tag::kChar, value);
+	return *this;
+}
+
+LogRecord &LogRecord::operator<<(const bool value)
+{
+	append(Tag::kBool, value);
+	return *this;
+}
+
+LogRecord &LogRecord::operator<<(const int value)
+{
+	return *this << static_cast<long long>(value);
+}
+
+LogRecord &LogRecord::operator<<(const unsigned int value)
+{
+	return *this << static_cast<unsigned long long>(value);
+}
+
+LogRecord &LogRecord::operator<<(const long value)
+{
+	return *this << static_cast<long long>(value);
+}
+
+LogRecord &LogRecord::operator<<(const unsigned long value)
+{
+	return *this << static_cast<unsigned long long>(value);
+}
+
+LogRecord &LogRecord::operator<<(const long long value)
+{
+	append(Tag::kSigned, value);
+	return *this;
+}
+
+LogRecord &LogRecord::operator<<(const unsigned long long value)
+{
+	append(Tag::kUnsigned, value);
+	return *this;
+}
+
+LogRecord &LogRecord::operator<<(const double value)
+{
+	append(Tag::kDouble, value);
+	return *this;
+}
+
+LogRecord &LogRecord::operator<<(const void *pointer)
+{
+	append(Tag::kPointer, pointer);
+	return *this;
+}
+
+void LogRecord::append_text(const char *text, size_t length)
+{
+	static constexpr size_t kHeaderSize{ sizeof(Tag) + sizeof(uint16_t) };
+	if (size_ + kHeaderSize >= kPayloadSize)
+	{
+		truncated_ = true;
+		return;
+	}
+
+	const auto room = kPayloadSize - size_ - kHeaderSize;
+	if (length > room)
+	{
+		length = room;
+		truncated_ = true;
+	}
+
+	const auto stored_length = static_cast<uint16_t>(length);
+	payload_[size_++] = static_cast<unsigned char>(Tag::kText);
+	std::memcpy(&payload_[size_], &stored_length, sizeof(stored_length));
+	size_ += sizeof(stored_length);
+	std::memcpy(&payload_[size_], text, length);
+	size_ += static_cast<uint16_t>(length);
+}
+
+void LogRecord::format(std::ostream &out) const
+{
+	out << file_ << ":" << line_ << ": " << level_prefix(level_);
+
+	size_t offset = 0;
+	const auto read = [this, &offset](void *value, const size_t size)
+	{
+		std::memcpy(value, &payload_[offset], size);
+		offset += size;
+	};
+	while (offset < size_)
+	{
+		const auto tag = static_cast<Tag>(payload_[offset++]);
+		switch (tag)
+		{
+		case Tag::kText:
+		{
+			uint16_t length;
+			read(&length, sizeof(length));
+			out.write(reinterpret_cast<const char*>(&payload_[offset]), length);
+			offset += length;
+			break;
+		}
+		case Tag::kChar:
+		{
+			char value;
+			read(&value, sizeof(value));
+			out << value;
+			break;
+		}
+		case Tag::kBool:
+		{
+			bool value;
+			read(&value, sizeof(value));
+			out << value;
+			break;
+		}
+		case Tag::kSigned:
+		{
+			long long value;
+			read(&value, sizeof(value));
+			out << value;
+			break;
+		}
+		case Tag::kUnsigned:
+		{
+			unsigned long long value;
+			read(&value, sizeof(value));
+			out << value;
+			break;
+		}
+		case Tag::kDouble:
+		{
+			double value;
+			read(&value, sizeof(value));
+			out << value;
+			break;
+		}
+		case Tag::kPointer:
+		{
+			const void *value;
+			read(&value, sizeof(value));
+			out << value;
+			break;
+		}
+		default:
+			out << "<corrupt log record>";
+			offset = size_;
+			break;
+		}
+	}
+
+	if (truncated_)
+	{
+		out << "...";
+	}
+	out << '\n';
+}
+
+Logger::Logger()
+	: slots_{}
+	, enqueue_position_{ 0 }
+	, dequeue_position_{ 0 }
+	, written_position_{ 0 }
+	, dropped_{ 0 }
+	, stopping_{ false }
+	, writer_{}
+{
+	for (size_t position = 0; position < kCapacity; ++position)
+	{
+		slots_[position].sequence_.store(position, std::memory_order_relaxed);
+	}
+	writer_ = std::thread{ &Logger::run, this };
+}
+
+Logger::~Logger()
+{
+	stopping_.store(true, std::memory_order_release);
+	writer_.join();
+}
+
+Logger &Logger::instance()
+{
+	static Logger logger{};
+	return logger;
+}
+
+bool Logger::push(const LogRecord &record)
+{
+	auto &logger = instance();
+
+	// claim a position; a slot is free to write once the writer's consumed the
+	// record from kCapacity positions ago
+	auto position = logger.enqueue_position_.load(std::memory_order_relaxed);
+	Slot *slot = nullptr;
+	for (;;)
+	{
+		slot = &logger.slots_[position & kMask];
+		const auto sequence = slot->sequence_.load(std::memory_order_acquire);
+		if (sequence == position)
+		{
+			if (logger.enqueue_position_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+			{
+				break;
+			}
+		}
+		else if (sequence < position)
+		{
+			// full
+			logger.dropped_.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+		else
+		{
+			// another producer claimed this position first
+			position = logger.enqueue_position_.load(std::memory_order_relaxed);
+		}
+	}
+
+	slot->record_ = record;
+	slot->sequence_.store(position + 1, std::memory_order_release);
+	return true;
+}
+
+void Logger::flush()
+{
+	auto &logger = instance();
+	if (std::this_thread::get_id() == logger.writer_.get_id())
+	{
+		return;
+	}
+
+	// positions claimed but not yet written hold up the writer, so this waits
+	// for them too
+	const auto target = logger.enqueue_position_.load(std::memory_order_acquire);
+	while (logger.written_position_.load(std::memory_order_acquire) < target)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds{ 1 });
+	}
+}
+
+size_t Logger::write_pending(std::ostream &out)
+{
+	size_t written = 0;
+	for (;;)
+	{
+		auto &slot = slots_[dequeue_position_ & kMask];
+		if (slot.sequence_.load(std::memory_order_acquire) != dequeue_position_ + 1)
+		{
+			break;
+		}
+
+		slot.record_.format(out);
+		slot.sequence_.store(dequeue_position_ + kCapacity, std::memory_order_release);
+		++dequeue_position_;
+		++written;
+	}
+
+	const auto dropped = dropped_.exchange(0, std::memory_order_relaxed);
+	if (dropped > 0)
+	{
+		out << "Logger: dropped " << dropped << " messages (buffer full)\n";
+	}
+	return written;
+}
+
+void Logger::run()
+{
+#ifdef LOG_USE_FILE_IO
+	std::ofstream file{ "log.txt" };
+	std::ostream &out = file;
+#else
+	std::ostream &out = std::cerr;
+#endif
+
+	for (;;)
+	{
+		// read before writing, so nothing pushed before stopping is missed
+		const auto stopping = stopping_.load(std::memory_order_acquire);
+		if (write_pending(out) > 0)
+		{
+			// one flush per batch rather than one per message
+			out.flush();
+			written_position_.store(dequeue_position_, std::memory_order_release);
+		}
+		else if (stopping)
+		{
+			break;
+		}
+		else
+		{
+			std::this_thread::sleep_for(kIdleSleep);
+		}
+	}
+}
+
+} // namespace util
\ No newline at end of file
@@ -0,0 +1,144 @@
+#ifndef LOGGER_H
+#define LOGGER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iosfwd>
+#include <string>
+#include <thread>
+
+namespace util {
+
+enum class LogLevel : uint8_t {
+	kDebug,
+	kInfo,
+	kWarning,
+	kError,
+	kNumLevels,
+};
+
+// One log message, captured w/o formatting it: each << copies its argument,
+// tagged w/ its type, into a fixed payload, & the writer thread turns the
+// payload into text later.  Whatever doesn't fit in the payload is dropped
+// (& the message marked as truncated)
+class LogRecord {
+public:
+	static constexpr size_t kPayloadSize{ 224 };
+
+	LogRecord()
+		: LogRecord{ LogLevel::kInfo, "", 0 }
+	{
+	}
+
+	// file must outlive the record; __FILE__ always does
+	LogRecord(const LogLevel level, const char *file, const int line)
+		: level_{ level }
+		, line_{ line }
+		, file_{ file }
+		, size_{ 0 }
+		, truncated_{ false }
+	{
+	}
+
+	LogRecord &operator<<(const char *text);
+	LogRecord &operator<<(const std::string &text);
+	LogRecord &operator<<(char value);
+	LogRecord &operator<<(bool value);
+	LogRecord &operator<<(int value);
+	LogRecord &operator<<(unsigned int value);
+	LogRecord &operator<<(long value);
+	LogRecord &operator<<(unsigned long value);
+	LogRecord &operator<<(long long value);
+	LogRecord &operator<<(unsigned long long value);
+	LogRecord &operator<<(double value);
+	LogRecord &operator<<(const void *pointer);
+
+	// writes "file:line: message" & a newline
+	void format(std::ostream &out) const;
+
+private:
+	enum class Tag : uint8_t {
+		kText, // uint16_t length, then the characters
+		kChar,
+		kBool,
+		kSigned,
+		kUnsigned,
+		kDouble,
+		kPointer,
+	};
+
+	void append_text(const char *text, size_t length);
+
+	template <typename Value>
+	void append(const Tag tag, const Value &value)
+	{
+		if (size_ + sizeof(tag) + sizeof(value) > kPayloadSize)
+		{
+			truncated_ = true;
+			return;
+		}
+		payload_[size_++] = static_cast<unsigned char>(tag);
+		std::memcpy(&payload_[size_], &value, sizeof(value));
+		size_ += sizeof(value);
+	}
+
+	LogLevel      level_;
+	int           line_;
+	const char   *file_;
+	uint16_t      size_; // bytes of payload_ used
+	bool          truncated_;
+	unsigned char payload_[kPayloadSize];
+}; // class LogRecord
+
+// Asynchronous log backend.  Any thread can push() a record into a bounded,
+// lock-free multi-producer ring buffer, which costs a copy & a couple of
+// atomics; a background thread formats the records & writes them out.  When
+// the buffer is full, records are dropped (& counted) rather than blocking
+// the caller
+class Logger {
+public:
+	static constexpr size_t kCapacity{ 1024 }; // records; must be a power of 2
+
+	// false if the record was dropped
+	static bool push(const LogRecord &record);
+	// blocks until everything pushed before the call has been written
+	static void flush();
+
+private:
+	// singleton; the writer thread lives as long as the instance
+	Logger();
+	~Logger();
+
+	Logger(const Logger&) = delete;
+	Logger &operator=(const Logger&) = delete;
+
+	static Logger &instance();
+
+	// formats every record that's been pushed, in order; returns how many
+	size_t write_pending(std::ostream &out);
+	void run();
+
+	static constexpr size_t kMask{ kCapacity - 1 };
+	static_assert((kCapacity & kMask) == 0, "Logger capacity must be a power of 2");
+
+	// sequence_ is the slot's position when it's free to write, position + 1
+	// once written, & position + kCapacity once the writer has consumed it
+	struct Slot {
+		std::atomic<size_t> sequence_;
+		LogRecord           record_;
+	};
+
+	Slot                slots_[kCapacity];
+	std::atomic<size_t> enqueue_position_; // next position a producer will claim
+	size_t              dequeue_position_; // next position to write; writer thread only
+	std::atomic<size_t> written_position_; // everything before this is written & flushed
+	std::atomic<size_t> dropped_;
+	std::atomic<bool>   stopping_;
+	std::thread         writer_;
+}; // class Logger
+
+} // namespace util
+
+#endif // LOGGER_H
\ No newline at end of file
@@ -1,45 +1,54 @@
 #ifndef LOGGING_H
 #define LOGGING_H
 
+#include "logger.h"
+
 #include <cassert>
 
+// where the logger's writer thread sends messages: log.txt, or stderr w/o this
 #define LOG_USE_FILE_IO
-#ifdef LOG_USE_FILE_IO
-#include <fstream>
 
-// TODO(sasiala): better file logging implementation
-static std::ofstream log_file_{ "log.txt" };
+// messages below this level (a LogLevel value) compile away; the check is a
+// constant, so a filtered-out LOG_*() costs nothing at runtime
+#ifndef UTIL_LOG_MIN_LEVEL
+#ifdef NDEBUG
+#define UTIL_LOG_MIN_LEVEL 1 // LogLevel::kInfo
+#else
+#define UTIL_LOG_MIN_LEVEL 0 // LogLevel::kDebug
+#endif
+#endif
 
-#define LOG(message) \
-do {\
-log_file_ << __FILE__ << ":" << __LINE__ << ": " << message << std::endl;\
-} while (0)
+// w/ no minimum every level passes; comparing against 0 would only trip -Wtype-limits
+#if UTIL_LOG_MIN_LEVEL > 0
+#define UTIL_LOG_LEVEL_ENABLED(level) (static_cast<int>(level) >= UTIL_LOG_MIN_LEVEL)
+#else
+#define UTIL_LOG_LEVEL_ENABLED(level) true
+#endif
 
-#define ASSERT(bex, message) \
+// message is anything that can follow "<<", e.g. LOG("Loaded " << count << " levels").
+// Arguments are copied into a record & formatted later on the logger's thread
+#define LOG_AT(level, message) \
 do {\
-if (!(bex)) {\
-log_file_ << "Assertion Failed: ";\
-LOG(message);\
-assert(false);\
+if (UTIL_LOG_LEVEL_ENABLED(level)) {\
+util::LogRecord log_record_{ level, __FILE__, __LINE__ };\
+log_record_ << message;\
+util::Logger::push(log_record_);\
 }\
 } while (0)
 
-#else
-#include <iostream>
-
-#define LOG(message) \
-do {\
-std::cerr << __FILE__ << ":" << __LINE__ << ": " << message << std::endl;\
-} while (0)
+#define LOG_DEBUG(message) LOG_AT(util::LogLevel::kDebug, message)
+#define LOG(message) LOG_AT(util::LogLevel::kInfo, message)
+#define LOG_WARNING(message) LOG_AT(util::LogLevel::kWarning, message)
+#define LOG_ERROR(message) LOG_AT(util::LogLevel::kError, message)
 
+// the failure is written out before asserting, so it isn't lost w/ the process
 #define ASSERT(bex, message) \
 do {\
 if (!(bex)) {\
-std::cerr << "Assertion Failed: ";\
-LOG(message);\
+LOG_ERROR("Assertion Failed: " << message);\
+util::Logger::flush();\
 assert(false);\
 }\
 } while (0)
-#endif
 
 #endif // LOGGING_H
\ No newline at end of file
@@ -1,13 +1,22 @@
 #include "main_menu.h"
 
+#include "gl_debug.h"
+#include "reset_gl_properties.h"
+
 #include <algorithm>
 
 namespace util {
 
-	MainMenu::MainMenu(Dimension load_width, Dimension load_height)
+	MainMenu::MainMenu(IResetGlProperties &gl_property_resetter, Dimension load_width, Dimension load_height)
 		: Element{ false }
+		, gl_property_resetter_{ gl_property_resetter }
 		, loaded_width_{ load_width }
 		, loaded_height_{ load_height }
+		, cache_width_{ load_width }
+		, cache_height_{ load_height }
+		, cache_fbo_{ 0 }
+		, cache_texture_id_{}
+		, cached_menu_{ nullptr }
 		, background_texture_id_ {}
 		, sprite_shader_id_{}
 		, background_color_{ 0.0f, 0.0f, 1.0f }
@@ -20,6 +29,14 @@ namespace util {
 	{
 	}
 
+	MainMenu::~MainMenu()
+	{
+		if (cache_fbo_)
+		{
+			glDeleteFramebuffers(1, &cache_fbo_);
+		}
+	}
+
 	void MainMenu::initialize_impl(const glm::mat4 &projection)
 	{
 		background_texture_id_ = ResourceManager::load_texture(kBackgroundTexturePath, false);
@@ -41,6 +58,36 @@ namespace util {
 
 		settings_menu_.initialize(projection);
 		settings_menu_.set_handler(*this);
+
+		glGenFramebuffers(1, &cache_fbo_);
+		glBindFramebuffer(GL_FRAMEBUFFER, cache_fbo_);
+		Texture2D cache_texture;
+		cache_texture.generate(cache_width_, cache_height_, nullptr, true);
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, cache_texture.id(), 0);
+		ASSERT(glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE, "Failed to initialize menu cache FBO");
+		gl_property_resetter_.reset_fbo();
+		cache_texture_id_ = ResourceManager::add_texture(cache_texture);
+		cached_menu_ = nullptr;
+
+		check_for_gl_errors();
+	}
+
+	void MainMenu::set_render_resolution(const Dimension width, const Dimension height)
+	{
+		if (width == cache_width_ && height == cache_height_)
+		{
+			return;
+		}
+
+		cache_width_ = width;
+		cache_height_ = height;
+		if (cache_fbo_)
+		{
+			// the texture stays attached to the FBO, so regenerating its storage is enough
+			Texture2D cache_texture{ ResourceManager::get_texture(cache_texture_id_) };
+			cache_texture.generate(cache_width_, cache_height_, nullptr, true);
+		}
+		cached_menu_ = nullptr;
 	}
 
 	void MainMenu::update_impl(const Time dt)
@@ -75,23 +122,37 @@ namespace util {
 			return;
 		}
 
-		render_background();
 		ASSERT(!menu_stack_.empty(), "No menu to render");
-		menu_stack_.back()->render(parent_sprite_renderer);
+		auto &menu = *menu_stack_.back();
+		if (cached_menu_ != &menu || menu.is_dirty())
+		{
+			render_cache(menu, parent_sprite_renderer);
+		}
+
+		// the texture's bottom row comes first, so it's drawn flipped
+		const auto width = static_cast<float>(loaded_width_);
+		const auto height = static_cast<float>(loaded_height_);
+		sprite_renderer_->draw(cache_texture_id_, { 0.0f, height }, { width, -height }, 0.0f);
 	}
 
-	void MainMenu::set_key_impl(const KeyId key_id, const bool val)
+	void MainMenu::render_cache(Element &menu, const Optional<SpriteRenderer*> parent_sprite_renderer)
 	{
-		if (!is_active())
-		{
-			return;
-		}
+		glBindFramebuffer(GL_FRAMEBUFFER, cache_fbo_);
+		// the menu's projection is unchanged, so it's scaled up to fill the cache
+		glViewport(0, 0, cache_width_, cache_height_);
+		glClear(GL_COLOR_BUFFER_BIT);
+
+		render_background();
+		menu.render(parent_sprite_renderer);
+
+		gl_property_resetter_.reset_fbo();
+		gl_property_resetter_.reset_viewport();
 
-		ASSERT(!menu_stack_.empty(), "No menu open to set key");
-		menu_stack_.back()->set_key(key_id, val);
+		menu.clear_dirty();
+		cached_menu_ = &menu;
 	}
 
-	void MainMenu::process_input_impl(const float dt)
+	void MainMenu::process_input_impl(const InputState &input, const Time dt)
 	{
 		if (!is_active())
 		{
@@ -99,13 +160,12 @@ namespace util {
 		}
 
 		ASSERT(!menu_stack_.empty(), "No menu open to process input");
-		menu_stack_.back()->process_input(dt);
+		menu_stack_.back()->process_input(input, dt);
 	}
 
 	void MainMenu::render_background()
 	{
-		const auto &background_texture = ResourceManager::get_texture(background_texture_id_);
-		sprite_renderer_->draw(background_texture, { 0.0f, 0.0f }, { loaded_width_, loaded_height_ }, 0.0f, background_color_);
+		sprite_renderer_->draw(background_texture_id_, { 0.0f, 0.0f }, { loaded_width_, loaded_height_ }, 0.0f, background_color_);
 	}
 
 } // namespace util
\ No newline at end of file
@@ -9,6 +9,12 @@
 
 namespace util {
 
+class IResetGlProperties;
+
+// The background & the open menu are rendered into a cached texture, which
+// is all that's drawn each frame; the cache is only re-rendered when the open
+// menu changes or something in it is marked dirty (e.g. a new highlight).
+// The cache is the framebuffer's size, so it's as sharp as drawing directly
 class MainMenu : public Element
 			   , public OpeningMenu::Handler
 			   , public LevelSelectionMenu::Handler 
@@ -43,7 +49,11 @@ public:
 		virtual void show_level_preview_impl() = 0;
 		virtual void hide_level_preview_impl() = 0;
 	};
-	MainMenu(Dimension load_width, Dimension load_height);
+	MainMenu(IResetGlProperties &gl_property_resetter, Dimension load_width, Dimension load_height);
+	~MainMenu();
+
+	MainMenu(const MainMenu&) = delete;
+	MainMenu &operator=(const MainMenu&) = delete;
 
 	void open_level_selection_next_activate()
 	{
@@ -61,6 +71,7 @@ public:
 	void set_background_color(const glm::vec3 &background_color)
 	{
 		background_color_ = background_color;
+		cached_menu_ = nullptr;
 	}
 
 	void update_current_level(const LevelSelectionMenu::MenuIndex current_level)
@@ -73,6 +84,9 @@ public:
 		level_selection_menu_.update_levels(levels, current_level);
 	}
 
+	// reallocates the cache at the new framebuffer size & marks it stale
+	void set_render_resolution(Dimension width, Dimension height);
+
 private:
 	// Element
 	void initialize_impl(const glm::mat4 &projection) override;
@@ -80,9 +94,7 @@ private:
 	void activate_impl() override;
 	void deactivate_impl() override;
 	void render_impl(Optional<SpriteRenderer*> parent_sprite_renderer) override;
-	void set_key_impl(KeyId key_id, bool val) override;
-	// TODO(sasiala): improve event handling
-	void process_input_impl(Time dt) override;
+	void process_input_impl(const InputState &input, Time dt) override;
 
 	void open_menu(Element &menu)
 	{
@@ -158,10 +170,19 @@ private:
 	}
 
 	void render_background();
+	void render_cache(Element &menu, Optional<SpriteRenderer*> parent_sprite_renderer);
+
+	IResetGlProperties &gl_property_resetter_;
 
 	Dimension loaded_width_;
 	Dimension loaded_height_;
 
+	Dimension                    cache_width_; // the framebuffer's size; loaded size until told
+	Dimension                    cache_height_;
+	unsigned int                 cache_fbo_;
+	ResourceManager::Texture2DId cache_texture_id_;
+	const Element               *cached_menu_; // the menu the cache shows; null if it's stale
+
 	static constexpr const char *kBackgroundTexturePath = "textures/background.jpg";
 	ResourceManager::Texture2DId background_texture_id_;
 
@@ -0,0 +1,136 @@
+#include "mapped_file.h"
+
+#include "logging.h"
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace util {
+
+#ifdef _WIN32
+	MappedFile::MappedFile(const char *path)
+		: data_{ nullptr }
+		, size_{ 0 }
+		, file_handle_{ INVALID_HANDLE_VALUE }
+		, mapping_handle_{ nullptr }
+	{
+		file_handle_ = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr,
+			OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (file_handle_ == INVALID_HANDLE_VALUE)
+		{
+			LOG("Failed to open file: " << path);
+			return;
+		}
+
+		LARGE_INTEGER file_size{};
+		if (!GetFileSizeEx(file_handle_, &file_size) || file_size.QuadPart == 0)
+		{
+			// empty files can't be mapped
+			close();
+			return;
+		}
+
+		mapping_handle_ = CreateFileMappingA(file_handle_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (!mapping_handle_)
+		{
+			LOG("Failed to map file: " << path);
+			close();
+			return;
+		}
+
+		data_ = static_cast<const unsigned char*>(MapViewOfFile(mapping_handle_, FILE_MAP_READ, 0, 0, 0));
+		if (!data_)
+		{
+			LOG("Failed to map view of file: " << path);
+			close();
+			return;
+		}
+		size_ = static_cast<size_t>(file_size.QuadPart);
+	}
+
+	void MappedFile::close()
+	{
+		if (data_)
+		{
+			UnmapViewOfFile(data_);
+		}
+		if (mapping_handle_)
+		{
+			CloseHandle(mapping_handle_);
+		}
+		if (file_handle_ != INVALID_HANDLE_VALUE)
+		{
+			CloseHandle(file_handle_);
+		}
+		data_ = nullptr;
+		size_ = 0;
+		mapping_handle_ = nullptr;
+		file_handle_ = INVALID_HANDLE_VALUE;
+	}
+#else
+	MappedFile::MappedFile(const char *path)
+		: data_{ nullptr }
+		, size_{ 0 }
+		, file_descriptor_{ -1 }
+	{
+		file_descriptor_ = open(path, O_RDONLY);
+		if (file_descriptor_ < 0)
+		{
+			LOG("Failed to open file: " << path);
+			return;
+		}
+
+		struct stat file_stat {};
+		if (fstat(file_descriptor_, &file_stat) != 0 || file_stat.st_size == 0)
+		{
+			// empty files can't be mapped
+			close();
+			return;
+		}
+
+		void *mapping = mmap(nullptr, static_cast<size_t>(file_stat.st_size), PROT_READ, MAP_PRIVATE, file_descriptor_, 0);
+		if (mapping == MAP_FAILED)
+		{
+			LOG("Failed to map file: " << path);
+			close();
+			return;
+		}
+
+		data_ = static_cast<const unsigned char*>(mapping);
+		size_ = static_cast<size_t>(file_stat.st_size);
+	}
+
+	void MappedFile::close()
+	{
+		if (data_)
+		{
+			munmap(const_cast<unsigned char*>(data_), size_);
+		}
+		if (file_descriptor_ >= 0)
+		{
+			::close(file_descriptor_);
+		}
+		data_ = nullptr;
+		size_ = 0;
+		file_descriptor_ = -1;
+	}
+#endif
+
+	MappedFile::~MappedFile()
+	{
+		close();
+	}
+
+} // namespace util
\ No newline at end of file
@@ -0,0 +1,49 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+
+namespace util {
+
+// Read-only memory mapping of a whole file.  The mapping lives as long as the
+// object; is_open() is false if the file couldn't be opened/mapped or is empty.
+class MappedFile {
+public:
+	explicit MappedFile(const char *path);
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile &operator=(const MappedFile&) = delete;
+
+	bool is_open() const
+	{
+		return data_ != nullptr;
+	}
+
+	const unsigned char *data() const
+	{
+		return data_;
+	}
+
+	size_t size() const
+	{
+		return size_;
+	}
+
+private:
+	void close();
+
+	const unsigned char *data_;
+	size_t               size_;
+
+#ifdef _WIN32
+	void *file_handle_;
+	void *mapping_handle_;
+#else
+	int file_descriptor_;
+#endif
+}; // class MappedFile
+
+} // namespace util
+
+#endif // MAPPED_FILE_H
\ No newline at end of file
@@ -14,10 +14,10 @@
 #include "label.h"
 
 #include <glm/glm.hpp>
-#include <GLFW/glfw3.h>
 
 #include <vector>
 #include <string>
+#include <utility>
 
 namespace util {
 
@@ -109,8 +109,6 @@ public:
 		, font_shader_id_{}
 		, default_font_id_{}
 		, menu_button_handler_{ nullptr }
-		, keys_pressed_{}
-		, keys_processed_{}
 	{
 	}
 
@@ -129,17 +127,24 @@ public:
 		menu_button_handler_ = &handler;
 	}
 
+	// the options are rebuilt in place: add_options is called w/ the emptied
+	// option list & emplace_back()s each option into it.  Handing over a whole
+	// list instead would copy every option's text, moved or not, since a
+	// Label's string is stored inline
+	template<typename AddOptions>
 	void update_info(const StringType  &title,
 		             const StringType  &subtitle,
 		             bool               show_back_label,
-		             const OptionList  &options,
+		             AddOptions         add_options,
 		             OptionIndex        selected_item)
 	{
 		title_label_.set_text(title);
 		subtitle_label_.set_text(subtitle);
 		conditionally_activate(back_label_, show_back_label);
 		selected_item_ = selected_item;
-		option_list_ = options;
+		option_list_.clear();
+		add_options(option_list_);
+		ASSERT(selected_item_ < option_list_.size(), "Selected item not among the options");
 		menu_button_handler_->apply_highlight(option_list_.at(selected_item_));
 	}
 
@@ -173,8 +178,6 @@ private:
 	}
 	void activate_impl() override
 	{
-		fill(keys_pressed_, false);
-		fill(keys_processed_, false);
 	}
 	void deactivate_impl() override
 	{
@@ -193,112 +196,36 @@ private:
 		apply(all_element_members, render_lambda, parent_sprite_renderer);
 	}
 
-	enum class ButtonsHandled {
-		kUpButton = 0,
-		kDownButton,
-		kEnterButton,
-		kBackButton,
-		kNumButtons,
-		kUnknown,
-	};
-	size_t to_index(const ButtonsHandled button_id)
-	{
-		ASSERT(ButtonsHandled::kNumButtons > button_id,
-			"Cannot convert to index (out of bounds)");
-		return static_cast<size_t>(button_id);
-	}
-	// TODO(sasiala): improve how key IDs are defined
-	ButtonsHandled convert_id(const KeyId button)
-	{
-		auto converted_id = ButtonsHandled::kUnknown;
-		switch (button)
-		{
-		case GLFW_KEY_W:
-			converted_id = ButtonsHandled::kUpButton;
-			break;
-		case GLFW_KEY_S:
-			converted_id = ButtonsHandled::kDownButton;
-			break;
-		case GLFW_KEY_ENTER:
-			converted_id = ButtonsHandled::kEnterButton;
-			break;
-		case GLFW_KEY_B:
-			converted_id = ButtonsHandled::kBackButton;
-			break;
-		default:
-			LOG("Unknown button id: " + std::to_string(button));
-			break;
-		}
-
-		return converted_id;
-	}
-	void set_key_impl(KeyId key_id, bool val) override
-	{
-		if (!is_active())
-		{
-			return;
-		}
-
-		bool *key_ptr = nullptr;
-		bool *key_processed_ptr = nullptr;
-		switch (convert_id(key_id))
-		{
-		case ButtonsHandled::kUpButton:
-		case ButtonsHandled::kDownButton:
-		case ButtonsHandled::kEnterButton:
-		case ButtonsHandled::kBackButton:
-			key_ptr = &keys_pressed_[to_index(convert_id(key_id))];
-			key_processed_ptr = &keys_processed_[to_index(convert_id(key_id))];
-			break;
-		default:
-			LOG("Unhandled key ID");
-			return;
-		}
-
-		// update keys & processed arrays accordingly
-		*key_ptr = val;
-		if (!val)
-		{
-			*key_processed_ptr = false;
-		}
-	}
-	void process_input_impl(Time dt) override
+	void process_input_impl(const InputState &input, Time /*dt*/) override
 	{
 		if (!is_active())
 		{
 			return;
 		}
 
-		if (keys_pressed_[to_index(ButtonsHandled::kEnterButton)]
-			&& !keys_processed_[to_index(ButtonsHandled::kEnterButton)])
+		if (input.pressed(InputAction::kMenuAccept))
 		{
 			menu_button_handler_->handle_menu_option_acceptance(selected_item_);
-			keys_processed_[to_index(ButtonsHandled::kEnterButton)] = true;
 		}
-		else if (keys_pressed_[to_index(ButtonsHandled::kBackButton)]
-			&& !keys_processed_[to_index(ButtonsHandled::kBackButton)])
+		else if (input.pressed(InputAction::kMenuBack))
 		{
 			if (back_label_.is_active())
 			{
 				menu_button_handler_->handle_back_button();
 			}
-			keys_processed_[to_index(ButtonsHandled::kBackButton)] = true;
 		}
 		else
 		{
 			menu_button_handler_->remove_highlight(option_list_.at(selected_item_));
 
-			if (keys_pressed_[to_index(ButtonsHandled::kDownButton)]
-				&& !keys_processed_[to_index(ButtonsHandled::kDownButton)])
+			if (input.pressed(InputAction::kMenuDown))
 			{
 				const auto number_of_items = option_list_.size();
 				selected_item_ = (selected_item_ + 1) % number_of_items;
 
 				menu_button_handler_->handle_menu_option_highlight(selected_item_);
-				keys_processed_[to_index(ButtonsHandled::kDownButton)] = true;
 			}
-			if (keys_pressed_[to_index(ButtonsHandled::kUpButton)]
-				&& !keys_processed_[to_index(ButtonsHandled::kUpButton)])
+			if (input.pressed(InputAction::kMenuUp))
 			{
 				const auto number_of_items = option_list_.size();
 				if (selected_item_ > 0)
@@ -312,12 +239,26 @@ private:
 				}
 
 				menu_button_handler_->handle_menu_option_highlight(selected_item_);
-				keys_processed_[to_index(ButtonsHandled::kUpButton)] = true;
 			}
 
 			menu_button_handler_->apply_highlight(option_list_.at(selected_item_));
 		}
 	}
+	bool is_dirty_impl() const override
+	{
+		for (const auto *element : all_element_members)
+		{
+			if (element->is_dirty())
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+	void clear_dirty_impl() override
+	{
+		apply(all_element_members, ElementLambdas::clear_dirty_pointer);
+	}
 
 	static constexpr const char *kDefaultFontPath = "fonts/OCRAEXT.TTF";
 	static constexpr util::TextRenderer::FontSize kDefaultFontSize{ 24 };
@@ -338,9 +279,6 @@ private:
 	ResourceManager::FontId   default_font_id_;
 
 	MenuButtonHandler *menu_button_handler_;
-
-	bool keys_pressed_[static_cast<size_t>(ButtonsHandled::kNumButtons)];
-	bool keys_processed_[static_cast<size_t>(ButtonsHandled::kNumButtons)];
 }; // class Menu
 
 } // namespace util
@@ -0,0 +1,218 @@
+#include "mixer_audio_backend.h"
+
+#include "logging.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace util {
+
+constexpr size_t MixerAudioBackend::kMaxSounds;
+constexpr size_t MixerAudioBackend::kMaxVoices;
+constexpr size_t MixerAudioBackend::kFramesPerBlock;
+
+MixerAudioBackend::MixerAudioBackend(IAudioSink *sink)
+	: sink_{ sink }
+	, pcm_{}
+	, pcm_paths_{}
+	, pcm_count_{ 0 }
+	, sounds_{}
+	, sound_settings_{}
+	, sound_count_{ 0 }
+	, commands_{}
+	, volume_{ 1.0f }
+	, music_{}
+	, voices_{}
+	, mix_buffer_{}
+	, output_block_{}
+	, stopping_{ false }
+	, mixer_{}
+{
+	ASSERT(sink_, "No audio sink");
+	mixer_ = std::thread{ &MixerAudioBackend::run, this };
+}
+
+MixerAudioBackend::~MixerAudioBackend()
+{
+	stopping_.store(true, std::memory_order_release);
+	mixer_.join();
+
+	delete sink_;
+	sink_ = nullptr;
+}
+
+IAudioBackend::SoundId MixerAudioBackend::load_sound_impl(const char *path, const SoundSettings &settings)
+{
+	ASSERT(sound_count_ < kMaxSounds, "Too many sounds loaded");
+	ASSERT(settings.max_voices_ > 0, "A sound needs at least one voice");
+
+	const auto sound_id = static_cast<SoundId>(sound_count_++);
+	const auto loaded = std::find(pcm_paths_, pcm_paths_ + pcm_count_, path);
+	if (loaded != pcm_paths_ + pcm_count_)
+	{
+		sounds_[sound_id] = &pcm_[loaded - pcm_paths_];
+	}
+	else
+	{
+		pcm_paths_[pcm_count_] = path;
+		decode_wav(path, pcm_[pcm_count_]);
+		sounds_[sound_id] = &pcm_[pcm_count_++];
+	}
+	sound_settings_[sound_id] = settings;
+	return sound_id;
+}
+
+void MixerAudioBackend::play_sound_impl(const SoundId sound_id)
+{
+	ASSERT(sound_id < sound_count_, "Unknown sound");
+
+	// a full queue means the mixer's fallen far behind; losing a sound is better than waiting
+	if (!commands_.push(Command{ sound_id }))
+	{
+		LOG_DEBUG("Audio command queue full, dropping sound " << sound_id);
+	}
+}
+
+void MixerAudioBackend::play_music_impl(const char *path, const bool loop)
+{
+	music_.play(path, loop);
+}
+
+void MixerAudioBackend::set_volume_impl(const Volume volume)
+{
+	volume_.store(std::min(std::max(volume, 0.0f), 1.0f), std::memory_order_relaxed);
+}
+
+IAudioBackend::Volume MixerAudioBackend::volume_impl() const
+{
+	return volume_.load(std::memory_order_relaxed);
+}
+
+void MixerAudioBackend::run()
+{
+	using Clock = std::chrono::steady_clock;
+	const auto block_duration = std::chrono::duration_cast<Clock::duration>(
+		std::chrono::duration<double>{ static_cast<double>(kFramesPerBlock) / kPcmSampleRate });
+
+	auto next_block = Clock::now();
+	while (!stopping_.load(std::memory_order_acquire))
+	{
+		Command command;
+		while (commands_.pop(command))
+		{
+			start_voice(command);
+		}
+
+		mix_block();
+		sink_->write(output_block_, kFramesPerBlock);
+
+		// paced by the clock; the sinks so far (null, wav file) don't have a
+		// device callback to pace it instead
+		next_block += block_duration;
+		std::this_thread::sleep_until(next_block);
+	}
+}
+
+void MixerAudioBackend::start_voice(const Command &command)
+{
+	const auto &pcm = *sounds_[command.sound_id_];
+	if (pcm.empty())
+	{
+		return;
+	}
+
+	const auto voice = choose_voice(command.sound_id_);
+	if (voice)
+	{
+		*voice = Voice{ &pcm, 0, command.sound_id_ };
+	}
+}
+
+MixerAudioBackend::Voice *MixerAudioBackend::choose_voice(const SoundId sound_id)
+{
+	// at its own limit, a sound restarts its oldest copy (furthest along); the
+	// fresh hit matters more than the tail of an old one
+	size_t playing = 0;
+	Voice *oldest_copy = nullptr;
+	Voice *free_voice = nullptr;
+	for (auto &voice : voices_)
+	{
+		if (!voice.pcm_)
+		{
+			free_voice = free_voice ? free_voice : &voice;
+		}
+		else if (voice.sound_id_ == sound_id)
+		{
+			++playing;
+			if (!oldest_copy || voice.frame_ > oldest_copy->frame_)
+			{
+				oldest_copy = &voice;
+			}
+		}
+	}
+	if (playing >= sound_settings_[sound_id].max_voices_)
+	{
+		return oldest_copy;
+	}
+	if (free_voice)
+	{
+		return free_voice;
+	}
+
+	// every voice is busy: steal the lowest priority one (the oldest of those),
+	// unless everything playing matters more than this sound
+	Voice *victim = nullptr;
+	for (auto &voice : voices_)
+	{
+		const auto priority = sound_settings_[voice.sound_id_].priority_;
+		if (!victim || priority < sound_settings_[victim->sound_id_].priority_ ||
+			(priority == sound_settings_[victim->sound_id_].priority_ && voice.frame_ > victim->frame_))
+		{
+			victim = &voice;
+		}
+	}
+	if (sound_settings_[victim->sound_id_].priority_ > sound_settings_[sound_id].priority_)
+	{
+		LOG_DEBUG("All voices busy w/ higher priority sounds, dropping sound " << sound_id);
+		return nullptr;
+	}
+	return victim;
+}
+
+void MixerAudioBackend::mix_block()
+{
+	std::memset(mix_buffer_, 0, sizeof(mix_buffer_));
+	for (auto &voice : voices_)
+	{
+		if (!voice.pcm_)
+		{
+			continue;
+		}
+
+		const auto frames_left = voice.pcm_->size() / kPcmChannels - voice.frame_;
+		const auto frames = std::min(frames_left, kFramesPerBlock);
+		const auto source = voice.pcm_->data() + voice.frame_ * kPcmChannels;
+		for (size_t sample = 0; sample < frames * kPcmChannels; ++sample)
+		{
+			mix_buffer_[sample] += source[sample];
+		}
+
+		voice.frame_ += frames;
+		if (voice.frame_ * kPcmChannels >= voice.pcm_->size())
+		{
+			voice.pcm_ = nullptr;
+		}
+	}
+	music_.mix(mix_buffer_, kFramesPerBlock);
+
+	// volume in 1/256ths, so the whole block is integer math
+	const auto volume = static_cast<int32_t>(volume_.load(std::memory_order_relaxed) * 256.0f);
+	for (size_t sample = 0; sample < kFramesPerBlock * kPcmChannels; ++sample)
+	{
+		const auto scaled = (mix_buffer_[sample] * volume) / 256;
+		output_block_[sample] = static_cast<int16_t>(std::min(std::max(scaled, -32768), 32767));
+	}
+}
+
+} // namespace util
\ No newline at end of file
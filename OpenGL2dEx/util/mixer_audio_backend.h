@@ -0,0 +1,87 @@
+#ifndef MIXER_AUDIO_BACKEND_H
+#define MIXER_AUDIO_BACKEND_H
+
+#include "audio_backend.h"
+#include "audio_sink.h"
+#include "music_streamer.h"
+#include "spsc_queue.h"
+#include "wav_decoder.h"
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <thread>
+
+namespace util {
+
+// Software mixer.  Sounds are decoded to PCM once, when loaded; a mixer
+// thread then mixes the playing voices a block at a time, in real time, &
+// hands each block to the sink.  The game thread only ever enqueues commands
+// (lock-free), so playing a sound never waits on the mixer.  Voices are
+// capped, per sound & overall, so a burst of sounds can't grow the mixing work.
+// Music is streamed rather than decoded up front (see MusicStreamer)
+class MixerAudioBackend : public IAudioBackend {
+public:
+	// takes ownership of the sink
+	explicit MixerAudioBackend(IAudioSink *sink);
+	~MixerAudioBackend() override;
+
+	MixerAudioBackend(const MixerAudioBackend&) = delete;
+	MixerAudioBackend &operator=(const MixerAudioBackend&) = delete;
+
+	static constexpr size_t kMaxSounds{ 16 };
+	static constexpr size_t kMaxVoices{ 32 }; // sounds playing at once
+	static constexpr size_t kFramesPerBlock{ 512 }; // ~12ms at kPcmSampleRate
+	static_assert(kFramesPerBlock <= MusicStreamer::kMaxMixFrames, "Mixer blocks are too big for the music streamer");
+
+private:
+	SoundId load_sound_impl(const char *path, const SoundSettings &settings) override;
+	void play_sound_impl(SoundId sound_id) override;
+	void play_music_impl(const char *path, bool loop) override;
+	void set_volume_impl(Volume volume) override;
+	Volume volume_impl() const override;
+
+	struct Command {
+		SoundId sound_id_;
+	};
+
+	struct Voice {
+		const PcmBuffer *pcm_; // null when the voice is free
+		size_t           frame_; // next frame to mix
+		SoundId          sound_id_;
+	};
+
+	void run();
+	void start_voice(const Command &command);
+	// the voice to (re)start a sound on, or null to drop it
+	Voice *choose_voice(SoundId sound_id);
+	void mix_block();
+
+	IAudioSink *sink_;
+
+	// written by the game thread before the sound's id is handed out, & never
+	// again, so the mixer can read any sound it's been told to play.  A file is
+	// decoded once; sounds loaded from the same file share its samples
+	PcmBuffer        pcm_[kMaxSounds];
+	std::string      pcm_paths_[kMaxSounds];
+	size_t           pcm_count_;
+	const PcmBuffer *sounds_[kMaxSounds];
+	SoundSettings    sound_settings_[kMaxSounds];
+	size_t           sound_count_;
+
+	SpscQueue<Command, 256> commands_;
+	std::atomic<Volume>     volume_;
+	MusicStreamer           music_;
+
+	// mixer thread only
+	Voice   voices_[kMaxVoices];
+	int32_t mix_buffer_[kFramesPerBlock * kPcmChannels];
+	int16_t output_block_[kFramesPerBlock * kPcmChannels];
+
+	std::atomic<bool> stopping_;
+	std::thread       mixer_;
+}; // class MixerAudioBackend
+
+} // namespace util
+
+#endif // MIXER_AUDIO_BACKEND_H
\ No newline at end of file
@@ -0,0 +1,150 @@
+#include "music_decoder.h"
+
+#include "logging.h"
+#include "wav_decoder.h"
+
+#include <cstring>
+#include <fstream>
+
+#define STB_VORBIS_HEADER_ONLY
+#include <stb_vorbis.c>
+
+namespace util {
+
+namespace {
+	class WavMusicDecoder : public IMusicDecoder {
+	public:
+		WavMusicDecoder()
+			: file_{}
+			, format_{}
+			, first_sample_{}
+			, frames_left_{ 0 }
+		{
+		}
+
+		bool open(const char *path)
+		{
+			file_.open(path, std::ios::binary);
+			if (!read_wav_header(file_, path, format_))
+			{
+				return false;
+			}
+			first_sample_ = file_.tellg();
+			frames_left_ = format_.frames_;
+			return true;
+		}
+
+	private:
+		size_t decode_impl(int16_t *pcm, const size_t frames) override
+		{
+			const auto decoded = decode_wav_frames(file_, format_, pcm, (frames < frames_left_) ? frames : frames_left_);
+			frames_left_ -= decoded;
+			return decoded;
+		}
+
+		bool rewind_impl() override
+		{
+			file_.clear();
+			file_.seekg(first_sample_);
+			frames_left_ = format_.frames_;
+			return static_cast<bool>(file_);
+		}
+
+		std::ifstream  file_;
+		WavFormat      format_;
+		std::streampos first_sample_;
+		size_t         frames_left_;
+	}; // class WavMusicDecoder
+
+	class VorbisMusicDecoder : public IMusicDecoder {
+	public:
+		VorbisMusicDecoder()
+			: vorbis_{ nullptr }
+		{
+		}
+
+		~VorbisMusicDecoder() override
+		{
+			if (vorbis_)
+			{
+				stb_vorbis_close(vorbis_);
+			}
+			vorbis_ = nullptr;
+		}
+
+		VorbisMusicDecoder(const VorbisMusicDecoder&) = delete;
+		VorbisMusicDecoder &operator=(const VorbisMusicDecoder&) = delete;
+
+		bool open(const char *path)
+		{
+			int error = 0;
+			vorbis_ = stb_vorbis_open_filename(path, &error, nullptr);
+			if (!vorbis_)
+			{
+				LOG_WARNING("Failed to open Vorbis file " << path << " (error " << error << ")");
+				return false;
+			}
+
+			const auto info = stb_vorbis_get_info(vorbis_);
+			if (info.sample_rate != kPcmSampleRate)
+			{
+				// the mixer doesn't resample, so other rates are rejected
+				LOG_WARNING("Unsupported sample rate in " << path << " (" << info.sample_rate << "Hz)");
+				return false;
+			}
+			return true;
+		}
+
+	private:
+		size_t decode_impl(int16_t *pcm, const size_t frames) override
+		{
+			// mixes/duplicates the file's channels down/up to kPcmChannels
+			return static_cast<size_t>(stb_vorbis_get_samples_short_interleaved(vorbis_,
+				static_cast<int>(kPcmChannels), pcm, static_cast<int>(frames * kPcmChannels)));
+		}
+
+		bool rewind_impl() override
+		{
+			return stb_vorbis_seek_start(vorbis_) != 0;
+		}
+
+		stb_vorbis *vorbis_;
+	}; // class VorbisMusicDecoder
+
+	bool has_extension(const char *path, const char *extension)
+	{
+		const auto path_length = std::strlen(path);
+		const auto extension_length = std::strlen(extension);
+		return path_length >= extension_length &&
+			std::strcmp(path + path_length - extension_length, extension) == 0;
+	}
+
+	template <typename Decoder>
+	IMusicDecoder *open_decoder(const char *path)
+	{
+		auto decoder = new Decoder{};
+		if (!decoder->open(path))
+		{
+			delete decoder;
+			return nullptr;
+		}
+		return decoder;
+	}
+} // namespace
+
+IMusicDecoder *open_music_decoder(const char *path)
+{
+	if (has_extension(path, ".wav"))
+	{
+		return open_decoder<WavMusicDecoder>(path);
+	}
+	if (has_extension(path, ".ogg"))
+	{
+		return open_decoder<VorbisMusicDecoder>(path);
+	}
+
+	LOG_WARNING("Unsupported music format: " << path);
+	return nullptr;
+}
+
+} // namespace util
\ No newline at end of file
@@ -0,0 +1,40 @@
+#ifndef MUSIC_DECODER_H
+#define MUSIC_DECODER_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace util {
+
+// Decodes a music track a chunk at a time, into the mixer's PCM format (see
+// wav_decoder.h), so a track of any length takes the same memory
+class IMusicDecoder {
+public:
+	virtual ~IMusicDecoder()
+	{
+	}
+
+	// decodes up to frames frames into pcm; fewer only at the end of the track
+	size_t decode(int16_t *pcm, const size_t frames)
+	{
+		return decode_impl(pcm, frames);
+	}
+
+	// back to the start, for looping
+	bool rewind()
+	{
+		return rewind_impl();
+	}
+
+private:
+	virtual size_t decode_impl(int16_t *pcm, size_t frames) = 0;
+	virtual bool rewind_impl() = 0;
+}; // class IMusicDecoder
+
+// Opens a .wav or .ogg (Vorbis) track, picked by extension; null (& logged)
+// if it can't be opened or its format isn't supported.  The caller owns it
+IMusicDecoder *open_music_decoder(const char *path);
+
+} // namespace util
+
+#endif // MUSIC_DECODER_H
\ No newline at end of file
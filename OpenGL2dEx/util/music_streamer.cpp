@@ -0,0 +1,236 @@
+#include "music_streamer.h"
+
+#include "logging.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace util {
+
+constexpr size_t MusicStreamer::kMaxPathLength;
+constexpr size_t MusicStreamer::kMaxMixFrames;
+constexpr size_t MusicStreamer::kCrossfadeFrames;
+constexpr size_t MusicStreamer::kNumDecks;
+constexpr size_t MusicStreamer::kRingSamples;
+constexpr size_t MusicStreamer::kChunkFrames;
+
+namespace {
+	// how often the decoder thread tops the rings up; far less than the ~0.75s
+	// each ring holds
+	constexpr std::chrono::milliseconds kFillInterval{ 10 };
+} // namespace
+
+MusicStreamer::MusicStreamer()
+	: decks_{}
+	, play_commands_{}
+	, started_decks_{}
+	, released_decks_{}
+	, chunk_{}
+	, mix_samples_{}
+	, stopping_{ false }
+	, decoder_thread_{}
+{
+	decoder_thread_ = std::thread{ &MusicStreamer::run, this };
+}
+
+MusicStreamer::~MusicStreamer()
+{
+	stopping_.store(true, std::memory_order_release);
+	decoder_thread_.join();
+
+	for (auto &deck : decks_)
+	{
+		release(deck);
+	}
+}
+
+void MusicStreamer::play(const char *path, const bool loop)
+{
+	PlayCommand command{};
+	ASSERT(std::strlen(path) < kMaxPathLength, "Music path too long");
+	std::strncpy(command.path_, path, kMaxPathLength - 1);
+	command.loop_ = loop;
+
+	if (!play_commands_.push(command))
+	{
+		LOG_WARNING("Too many music requests queued, dropping " << path);
+	}
+}
+
+void MusicStreamer::mix(int32_t *mix, const size_t frames)
+{
+	ASSERT(frames <= kMaxMixFrames, "Too many music frames mixed at once");
+
+	size_t deck_index;
+	while (started_decks_.pop(deck_index))
+	{
+		fade_in(deck_index);
+	}
+
+	for (size_t index = 0; index < kNumDecks; ++index)
+	{
+		auto &deck = decks_[index];
+		if (!deck.playing_)
+		{
+			continue;
+		}
+
+		// read finished_ first; if it's set, every sample's already in the ring
+		const auto finished = deck.finished_.load(std::memory_order_acquire);
+		const auto samples = deck.samples_.pop(mix_samples_, frames * kPcmChannels);
+		for (size_t sample = 0; sample < samples; sample += kPcmChannels)
+		{
+			deck.gain_ = std::min(std::max(deck.gain_ + deck.gain_step_, 0.0f), 1.0f);
+			for (size_t channel = 0; channel < kPcmChannels; ++channel)
+			{
+				mix[sample + channel] += static_cast<int32_t>(mix_samples_[sample + channel] * deck.gain_);
+			}
+		}
+
+		// running short of samples otherwise just means the decoder's behind,
+		// which plays as silence until it catches up
+		const auto faded_out = deck.gain_step_ < 0.0f && deck.gain_ <= 0.0f;
+		if ((finished && samples < frames * kPcmChannels) || faded_out)
+		{
+			stop(index);
+		}
+	}
+}
+
+void MusicStreamer::run()
+{
+	PlayCommand pending{};
+	auto has_pending = false;
+	while (!stopping_.load(std::memory_order_acquire))
+	{
+		size_t deck_index;
+		while (released_decks_.pop(deck_index))
+		{
+			release(decks_[deck_index]);
+		}
+
+		// only the latest request matters
+		PlayCommand command;
+		while (play_commands_.pop(command))
+		{
+			pending = command;
+			has_pending = true;
+		}
+		// both decks busy means a crossfade's running; the mixer frees one once
+		// it's done
+		const auto free_deck = std::find_if(std::begin(decks_), std::end(decks_), [](const Deck &deck) { return !deck.in_use_; });
+		if (has_pending && free_deck != std::end(decks_))
+		{
+			start(pending);
+			has_pending = false;
+		}
+
+		for (auto &deck : decks_)
+		{
+			if (deck.in_use_)
+			{
+				fill(deck);
+			}
+		}
+
+		std::this_thread::sleep_for(kFillInterval);
+	}
+}
+
+void MusicStreamer::start(const PlayCommand &command)
+{
+	const auto decoder = open_music_decoder(command.path_);
+	if (!decoder)
+	{
+		return;
+	}
+
+	const auto deck = std::find_if(std::begin(decks_), std::end(decks_), [](const Deck &deck) { return !deck.in_use_; });
+	ASSERT(deck != std::end(decks_), "No free music deck");
+	deck->decoder_ = decoder;
+	deck->loop_ = command.loop_;
+	deck->in_use_ = true;
+	deck->finished_.store(false, std::memory_order_relaxed);
+
+	// fill the ring before the mixer sees it, so the track doesn't start w/ an underrun
+	fill(*deck);
+	if (!started_decks_.push(static_cast<size_t>(deck - std::begin(decks_))))
+	{
+		LOG_WARNING("Too many music tracks started at once, dropping " << command.path_);
+		release(*deck);
+	}
+}
+
+void MusicStreamer::fill(Deck &deck)
+{
+	constexpr auto kChunkSamples = kChunkFrames * kPcmChannels;
+	while (!deck.finished_.load(std::memory_order_relaxed) && kRingSamples - deck.samples_.size() >= kChunkSamples)
+	{
+		auto frames = deck.decoder_->decode(chunk_, kChunkFrames);
+		if (frames < kChunkFrames && deck.loop_)
+		{
+			// finish the chunk from the top of the track, so the loop has no gap
+			while (frames < kChunkFrames && deck.decoder_->rewind())
+			{
+				const auto decoded = deck.decoder_->decode(chunk_ + frames * kPcmChannels, kChunkFrames - frames);
+				if (decoded == 0)
+				{
+					break; // an empty track would loop forever
+				}
+				frames += decoded;
+			}
+		}
+
+		deck.samples_.push(chunk_, frames * kPcmChannels);
+		if (frames < kChunkFrames)
+		{
+			deck.finished_.store(true, std::memory_order_release);
+		}
+	}
+}
+
+void MusicStreamer::release(Deck &deck)
+{
+	delete deck.decoder_;
+	deck.decoder_ = nullptr;
+	deck.samples_.clear();
+	deck.in_use_ = false;
+}
+
+void MusicStreamer::fade_in(const size_t deck_index)
+{
+	const auto gain_step = 1.0f / kCrossfadeFrames;
+	for (size_t index = 0; index < kNumDecks; ++index)
+	{
+		auto &deck = decks_[index];
+		if (index == deck_index || !deck.playing_)
+		{
+			continue;
+		}
+
+		if (deck.gain_step_ < 0.0f)
+		{
+			// already fading out from an earlier change; cut it, to free its deck
+			stop(index);
+		}
+		else
+		{
+			deck.gain_step_ = -gain_step;
+		}
+	}
+
+	auto &deck = decks_[deck_index];
+	deck.playing_ = true;
+	deck.gain_ = 0.0f;
+	deck.gain_step_ = gain_step;
+}
+
+void MusicStreamer::stop(const size_t deck_index)
+{
+	decks_[deck_index].playing_ = false;
+	// can't fail; there are never more decks in use than the queue holds
+	released_decks_.push(deck_index);
+}
+
+} // namespace util
\ No newline at end of file
@@ -0,0 +1,103 @@
+#ifndef MUSIC_STREAMER_H
+#define MUSIC_STREAMER_H
+
+#include "music_decoder.h"
+#include "spsc_queue.h"
+#include "wav_decoder.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+namespace util {
+
+// Streams music tracks for the mixer.  A decoder thread decodes each track a
+// chunk at a time into a ring buffer, which the mixer drains; memory use is
+// the same for any track length, & neither the game thread nor the mixer
+// ever waits on decoding.  Looping tracks wrap around inside a chunk, so
+// there's no gap, & starting a track crossfades from the one playing
+class MusicStreamer {
+public:
+	static constexpr size_t kMaxPathLength{ 256 };
+	static constexpr size_t kMaxMixFrames{ 1024 }; // per mix() call
+	static constexpr size_t kCrossfadeFrames{ kPcmSampleRate * 3 / 2 };
+
+	MusicStreamer();
+	~MusicStreamer();
+
+	MusicStreamer(const MusicStreamer&) = delete;
+	MusicStreamer &operator=(const MusicStreamer&) = delete;
+
+	// game thread; never blocks.  If several tracks are requested before the
+	// decoder gets to them, only the last is played
+	void play(const char *path, bool loop);
+
+	// mixer thread; adds the next frames of music to mix (kPcmChannels samples
+	// per frame).  Plays silence where the decoder's fallen behind
+	void mix(int32_t *mix, size_t frames);
+
+private:
+	static constexpr size_t kNumDecks{ 2 }; // the track fading in & the one fading out
+	static constexpr size_t kRingSamples{ 65536 }; // per deck, ~0.75s
+	static constexpr size_t kChunkFrames{ 4096 }; // decoded at a time
+
+	struct PlayCommand {
+		char path_[kMaxPathLength];
+		bool loop_;
+	};
+
+	// one track being streamed
+	struct Deck {
+		Deck()
+			: decoder_{ nullptr }
+			, loop_{ false }
+			, in_use_{ false }
+			, samples_{}
+			, finished_{ false }
+			, playing_{ false }
+			, gain_{ 0.0f }
+			, gain_step_{ 0.0f }
+		{
+		}
+
+		// decoder thread only
+		IMusicDecoder *decoder_;
+		bool           loop_;
+		bool           in_use_; // from being started until the mixer releases it
+
+		SpscQueue<int16_t, kRingSamples> samples_; // decoder thread -> mixer
+		std::atomic<bool>                finished_; // set once the last sample's pushed
+
+		// mixer thread only
+		bool  playing_;
+		float gain_;
+		float gain_step_; // per frame; > 0 fading in, < 0 fading out
+	};
+
+	// decoder thread
+	void run();
+	void start(const PlayCommand &command);
+	void fill(Deck &deck);
+	void release(Deck &deck);
+
+	// mixer thread
+	void fade_in(size_t deck_index);
+	void stop(size_t deck_index);
+
+	Deck decks_[kNumDecks];
+
+	SpscQueue<PlayCommand, 8> play_commands_; // game -> decoder thread
+	SpscQueue<size_t, 8>      started_decks_; // decoder -> mixer thread
+	SpscQueue<size_t, 8>      released_decks_; // mixer -> decoder thread
+
+	int16_t chunk_[kChunkFrames * kPcmChannels]; // decoder thread
+	int16_t mix_samples_[kMaxMixFrames * kPcmChannels]; // mixer thread
+
+	std::atomic<bool> stopping_;
+	std::thread       decoder_thread_;
+}; // class MusicStreamer
+
+} // namespace util
+
+#endif // MUSIC_STREAMER_H
\ No newline at end of file
@@ -19,21 +19,16 @@ namespace {
 		return{ OpeningMenu::LabelType{ true, kXRatio, kYTopRatio + (index * kRowHeightRatio), kTextScaleFromHeight, text_color, level_name, viewport_width, viewport_height } };
 	}
 
-	std::pair<OpeningMenu::MenuIndex, OpeningMenu::MenuList> menu_list(const OpeningMenu::OptionList &option_list, const Dimension viewport_width, const Dimension viewport_height)
+	void add_menu_options(OpeningMenu::MenuList &menu_list, const OpeningMenu::OptionList &option_list, const Dimension viewport_width, const Dimension viewport_height)
 	{
-		auto menu_list_pair = std::make_pair<OpeningMenu::MenuIndex, OpeningMenu::MenuList>({ 0 }, {});
-
 		for (auto i = size_t{ 0 }; i < OpeningMenu::kMaxItems; ++i)
 		{
 			const auto &str = option_list[i];
 			if (strcmp(str, "") == 0)
 				break;
 
-			++menu_list_pair.first;
-			menu_list_pair.second.push_back(menu_list_object(str, i, viewport_width, viewport_height));
+			menu_list.emplace_back(menu_list_object(str, i, viewport_width, viewport_height));
 		}
-
-		return menu_list_pair;
 	}
 } // namespace
 
@@ -50,7 +45,11 @@ namespace {
 	{
 		menu_.initialize(projection);
 		menu_.set_menu_handler(*this);
-		menu_.update_info("MAIN MENU", "", false, menu_list(kOptions, load_width_, load_height_).second, 0);
+		const auto load_width = load_width_;
+		const auto load_height = load_height_;
+		menu_.update_info("MAIN MENU", "", false, [load_width, load_height](MenuList &menu_list) {
+			add_menu_options(menu_list, kOptions, load_width, load_height);
+		}, 0);
 	}
 
 	void OpeningMenu::update_impl(Time dt)
@@ -78,24 +77,24 @@ namespace {
 		menu_.render(parent_sprite_renderer);
 	}
 
-	void OpeningMenu::set_key_impl(KeyId key_id, bool val)
+	void OpeningMenu::process_input_impl(const InputState &input, Time dt)
 	{
 		if (!is_active())
 		{
 			return;
 		}
-		
-		menu_.set_key(key_id, val);
+
+		menu_.process_input(input, dt);
 	}
 
-	void OpeningMenu::process_input_impl(Time dt)
+	bool OpeningMenu::is_dirty_impl() const
 	{
-		if (!is_active())
-		{
-			return;
-		}
+		return menu_.is_dirty();
+	}
 
-		menu_.process_input(dt);
+	void OpeningMenu::clear_dirty_impl()
+	{
+		menu_.clear_dirty();
 	}
 
 	void OpeningMenu::handle_menu_option_highlight_impl(const MenuIndex /*index*/)
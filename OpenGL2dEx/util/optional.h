@@ -2,6 +2,9 @@
 #define OPTIONAL_H
 
 #include <cassert>
+#include <new>
+#include <type_traits>
+#include <utility>
 
 // TODO(sasiala): this optional ws just an initial thing to 
 // get things working.  It needs a lot of work.
@@ -11,6 +14,17 @@ namespace util {
 	};
 	constexpr nullopt_t nullopt{0};
 
+	template<typename T>
+	class Optional;
+
+	template<typename T>
+	struct is_optional : std::false_type {};
+
+	template<typename T>
+	struct is_optional<Optional<T>> : std::true_type {};
+
+	// the value lives in raw storage & is only constructed while the
+	// optional has one, so T needn't be default constructible
 	template<typename T>
 	class Optional {
 	public:
@@ -26,56 +40,130 @@ namespace util {
 		{
 		}
 
-		constexpr Optional(const Optional &other)
-			: data_{ other.data_ }
-			, has_data_{ other.has_data_ }
+		Optional(const Optional &other)
+			: data_{}
+			, has_data_{ false }
 		{
+			if (other.has_data_)
+			{
+				emplace(*other);
+			}
 		}
 
-		constexpr Optional(Optional &&other) noexcept
-			: data_{ std::move(other.data_)}
-			, has_data_{ std::move(other.has_data_) }
+		Optional(Optional &&other) noexcept(std::is_nothrow_move_constructible<T>::value)
+			: data_{}
+			, has_data_{ false }
 		{
+			if (other.has_data_)
+			{
+				emplace(std::move(*other));
+			}
 		}
 
-		template<typename T>
-		Optional(const T &data) noexcept
-			: data_{data}
-			, has_data_{true}
+		template<typename U,
+			typename = std::enable_if_t<std::is_constructible<T, U&&>::value>,
+			typename = std::enable_if_t<!is_optional<std::decay_t<U>>::value>,
+			typename = std::enable_if_t<!std::is_same<std::decay_t<U>, nullopt_t>::value>>
+		Optional(U &&data) noexcept(std::is_nothrow_constructible<T, U&&>::value)
+			: data_{}
+			, has_data_{ false }
 		{
+			emplace(std::forward<U>(data));
 		}
 
-		template<typename T>
-		Optional(const Optional<T> &other)
-			: data_{ other.data_ }
-			, has_data_{ other.has_data_ }
+		template<typename U>
+		Optional(const Optional<U> &other)
+			: data_{}
+			, has_data_{ false }
 		{
+			if (other)
+			{
+				emplace(*other);
+			}
 		}
 
 		// TODO(sasiala): implement comparison operators
 
-		constexpr Optional& operator=(const Optional &other) const
+		Optional& operator=(nullopt_t) noexcept
 		{
-			if (!has_data_ && !other.has_data_)
+			reset();
+			return *this;
+		}
+
+		Optional& operator=(const Optional &other)
+		{
+			if (this == &other)
 			{
 				return *this;
 			}
-			
-			if (has_data_ && !other.has_data_)
+
+			if (!other.has_data_)
 			{
-				~data_();
-				has_data_ = false;
+				reset();
 			}
-			else if (has_data_ && other.has_data_)
+			else if (has_data_)
+			{
+				**this = *other;
+			}
+			else
+			{
+				emplace(*other);
+			}
+			return *this;
+		}
+
+		Optional& operator=(Optional &&other) noexcept(std::is_nothrow_move_constructible<T>::value &&
+													   std::is_nothrow_move_assignable<T>::value)
+		{
+			if (this == &other)
 			{
-				data_ = other.data_;
+				return *this;
 			}
 
-			has_data_ = other->has_data_;
-			data_ = other->has_data_;
+			if (!other.has_data_)
+			{
+				reset();
+			}
+			else if (has_data_)
+			{
+				**this = std::move(*other);
+			}
+			else
+			{
+				emplace(std::move(*other));
+			}
 			return *this;
 		}
 
+		~Optional()
+		{
+			reset();
+		}
+
+		// destroys any held value & constructs the new one in place
+		template<typename ...Args>
+		T& emplace(Args&&... args)
+		{
+			reset();
+			new(data_) T(std::forward<Args>(args)...);
+			has_data_ = true;
+			return **this;
+		}
+
+		void reset() noexcept
+		{
+			if (has_data_)
+			{
+				value_ptr()->~T();
+				has_data_ = false;
+			}
+		}
+
+		bool has_value() const
+		{
+			return has_data_;
+		}
+
 		operator bool() const
 		{
 			return has_data_;
@@ -84,38 +172,44 @@ namespace util {
 		T& operator*()
 		{
 			assert(has_data_);
-			return data_;
+			return *value_ptr();
 		}
 
 		const T& operator*() const
 		{
 			assert(has_data_);
-			return data_;
+			return *value_ptr();
 		}
 
 		T *operator->()
 		{
 			assert(has_data_);
-			return &data_;
+			return value_ptr();
 		}
 
 		const T *operator->() const
 		{
 			assert(has_data_);
-			return &data_;
-		}
-
-		~Optional()
-		{
+			return value_ptr();
 		}
 		
 		// TODO(sasiala): there are a ton more members to implement
 
 	private:
-		T	 data_;
-		bool has_data_;
+		T *value_ptr()
+		{
+			return reinterpret_cast<T*>(data_);
+		}
+
+		const T *value_ptr() const
+		{
+			return reinterpret_cast<const T*>(data_);
+		}
+
+		alignas(T) unsigned char data_[sizeof(T)];
+		bool                     has_data_;
 	};
 
 } // namespace util
 
-#endif // !OPTIONAL_H
+#endif // !OPTIONAL_H
\ No newline at end of file
@@ -0,0 +1,33 @@
+#ifndef PARALLEL_FOR_H
+#define PARALLEL_FOR_H
+
+#include "worker_pool.h"
+
+#include <algorithm>
+#include <cstddef>
+
+namespace util {
+
+// Calls function(begin, end) for contiguous chunks covering [0, count), one
+// chunk per WorkerPool thread (the calling thread takes the first), & returns
+// once all are done.  Chunks hold at least min_chunk items, so small counts run
+// inline w/o waking any workers.  A wake-up costs a few microseconds, so
+// min_chunk should be large enough to make that worthwhile
+template <typename Function>
+void parallel_for(const size_t count, const size_t min_chunk, Function function)
+{
+	const auto chunks = std::min(WorkerPool::thread_count(), count / std::max<size_t>(min_chunk, 1));
+	if (chunks <= 1)
+	{
+		function(size_t{ 0 }, count);
+		return;
+	}
+
+	WorkerPool::run([](void *context, const size_t begin, const size_t end) {
+		(*static_cast<Function*>(context))(begin, end);
+	}, &function, count, chunks);
+}
+
+} // namespace util
+
+#endif // PARALLEL_FOR_H
\ No newline at end of file
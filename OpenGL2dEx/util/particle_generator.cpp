@@ -2,7 +2,6 @@
 
 #include "gl_debug.h"
 
-#include "game_object.h"
 #include "resource_mgr.h"
 
 #include <algorithm>
@@ -12,23 +11,25 @@ namespace util {
 
 namespace {
 	void respawn_particle(ParticleGenerator::Particle &particle, 
-						  GameObject &object, 
+						  const glm::vec2 &position,
+						  const glm::vec2 &velocity,
 						  const glm::vec2 &offset)
 	{
 		float random = ((rand() % 100) - 50) / 10.0f;
 		float r_color = 0.5f + ((rand() % 100) / 100.0f);
-		particle.position_ = object.position() + random + offset;
+		particle.position_ = position + random + offset;
 		particle.color_ = glm::vec4(r_color, r_color, r_color, 1.0f);
 		particle.life_ = 1.0f;
-		particle.velocity_ = object.velocity() * 0.1f;
+		particle.velocity_ = velocity * 0.1f;
 	}
 } // namespace
 
-void ParticleGenerator::update(float dt, GameObject &object, unsigned int new_particles, Optional<glm::vec2> offset)
+void ParticleGenerator::update(float dt, const glm::vec2 &position, const glm::vec2 &velocity,
+							   unsigned int new_particles, Optional<glm::vec2> offset)
 {
 	for (size_t i = 0; i < new_particles; ++i)
 	{
-		respawn_particle(particles_.at(pop_vertex()), object, (offset) ? *offset : glm::vec2(0.0f, 0.0f));
+		respawn_particle(particles_.at(pop_vertex()), position, velocity, (offset) ? *offset : glm::vec2(0.0f, 0.0f));
 	}
 
 	for (size_t i = 0; i < particles_.size(); ++i)
@@ -57,13 +58,14 @@ void ParticleGenerator::draw()
 	glBlendFunc(GL_SRC_ALPHA, GL_ONE);
 
 	shader_.use();
+	const auto &texture = ResourceManager::get_texture(texture_id_);
 	for (auto &particle : particles_)
 	{
 		if (particle.life_ > 0.0f)
 		{
 			shader_.set_vec2("u_offset_", particle.position_, false);
 			shader_.set_vec4("u_color_", particle.color_, false);
-			texture_.bind();
+			texture.bind();
 
 			glBindVertexArray(vao_);
 			glDrawArrays(GL_TRIANGLES, 0, 6);
@@ -90,6 +92,8 @@ void ParticleGenerator::clear_particles()
 
 void ParticleGenerator::initialize(const glm::mat4 &projection)
 {
+	// never holds more than every particle, so freeing particles never reallocates
+	unused_vertices_.reserve(max_particles_);
 	for (size_t i = 0; i < max_particles_; ++i)
 	{
 		unused_vertices_.push_back(i);
@@ -2,16 +2,14 @@
 #define PARTICLE_GENERATOR_H
 
 #include "optional.h"
+#include "resource_mgr.h"
 #include "shader.h"
-#include "texture_2d.h"
 
 #include <glm/glm.hpp>
 #include <vector>
 
 namespace util {
 
-class GameObject;
-
 class ParticleGenerator {
 public:
 	struct Particle {
@@ -29,9 +27,9 @@ public:
 		float     life_;
 	}; // class Particle
 
-	ParticleGenerator(Shader shader, Texture2D texture, size_t max_particles, const glm::mat4 &projection)
+	ParticleGenerator(Shader shader, ResourceManager::Texture2DId texture_id, size_t max_particles, const glm::mat4 &projection)
 		: shader_{ shader }
-		, texture_{ texture }
+		, texture_id_{ texture_id }
 		, max_particles_{ max_particles }
 		, particles_(max_particles, Particle{})
 		, unused_vertices_{}
@@ -40,7 +38,9 @@ public:
 		initialize(projection);
 	}
 
-	void update(float dt, GameObject &object, unsigned int new_particles, Optional<glm::vec2> offset);
+	// emits new_particles from an object at position moving at velocity
+	void update(float dt, const glm::vec2 &position, const glm::vec2 &velocity,
+				unsigned int new_particles, Optional<glm::vec2> offset);
 	void draw();
 
 	void clear_particles();
@@ -56,7 +56,7 @@ private:
 	void initialize(const glm::mat4 &projection);
 
 	Shader shader_;
-	Texture2D texture_;
+	ResourceManager::Texture2DId texture_id_;
 
 	const size_t		  max_particles_;
 	std::vector<Particle> particles_;
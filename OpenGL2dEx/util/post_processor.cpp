@@ -3,40 +3,69 @@
 #include "logging.h"
 #include "gl_debug.h"
 #include "reset_gl_properties.h"
+#include "scoped_timer.h"
+
+#include <algorithm>
+#include <initializer_list>
 
 namespace util {
 
+namespace {
+	// RGB8 targets are padded to 4 bytes/pixel by every driver we care about
+	constexpr PostProcessor::ByteCount kBytesPerPixel{ 4 };
+} // namespace
+
+PostProcessor::SampleCount PostProcessor::requested_msaa_samples_{ 4 };
 
 PostProcessor::PostProcessor(const IResetGlProperties& gl_property_resetter,
 							 const Shader    &post_processing_shader,
+							 const Shader    &blur_shader,
+							 const Shader    &edge_shader,
+							 const Shader    &invert_shader,
 							 glm::vec2       position,
 							 unsigned int    width,
 							 unsigned int    height,
 							 const glm::mat4 &projection)
 	: gl_property_resetter_{ gl_property_resetter }
 	, post_processing_shader_ { post_processing_shader }
+	, blur_shader_{ blur_shader }
+	, edge_shader_{ edge_shader }
+	, invert_shader_{ invert_shader }
 	, texture_{}
 	, position_{ position }
 	, width_{ width }
 	, height_{ height }
+	, display_width_{ width }
+	, display_height_{ height }
+	, resolution_scale_{ 1.0f }
+	, scaled_width_{ width }
+	, scaled_height_{ height }
+	, blit_destination_{}
 	, confuse_{ false }
 	, chaos_{ false }
 	, shake_{ false }
+	, msaa_samples_{ 0 }
+	, msaa_samples_request_{ 0 }
+	, pass_fbos_{}
+	, pass_textures_{}
+	, next_pass_target_{ 0 }
+	, bytes_saved_last_frame_{ 0 }
+	, bytes_saved_total_{ 0 }
+	, frames_rendered_{ 0 }
+	, idle_frames_rendered_{ 0 }
 {
+	update_blit_destination();
+
 	glGenFramebuffers(1, &msfbo_);
 	glGenFramebuffers(1, &fbo_);
 	glGenRenderbuffers(1, &rbo_);
 
 	// initialize renderbuffer storage w/ a multisampled color buffer
-	glBindFramebuffer(GL_FRAMEBUFFER, msfbo_);
-	glBindRenderbuffer(GL_RENDERBUFFER, rbo_);
-	glRenderbufferStorageMultisample(GL_RENDERBUFFER, 4, GL_RGB, width, height); // allocate storage for render buffer
-	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, rbo_);
-	ASSERT(glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE, "Failed to initialize MSFBO");
+	allocate_msaa_storage();
 
 	// also initialize FBO/texture to blit multisampled color-buffer to
 	glBindFramebuffer(GL_FRAMEBUFFER, fbo_);
-	texture_.generate(width, height, nullptr, true);
+	texture_.generate(width_, height_, nullptr, true);
 
 	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture_.id(), 0);
 	ASSERT(glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE, "Failed to initialize FBO");
@@ -44,45 +73,69 @@ PostProcessor::PostProcessor(const IResetGlProperties& gl_property_resetter,
 	glBindFramebuffer(GL_FRAMEBUFFER, 0);
 
 	initialize_render_data();
+	initialize_pass_targets();
 	
 	post_processing_shader_.use();
 	post_processing_shader_.set_mat4("u_projection_", projection, false);
 	post_processing_shader_.set_int("u_scene_", 0, false);
-	static constexpr float offset = 1.0f / 300.0f;
-	static const float offsets[9][2] = {
-		{ -offset, offset },
-		{ 0.0f,    offset },
-		{ offset,  offset },
-		{ -offset, 0.0f   },
-		{ 0.0f,    0.0f   },
-		{ offset,  0.0f   },
-		{ -offset, -offset},
-		{ 0.0f,    -offset},
-		{ offset,  -offset}
-	};
-	glUniform2fv(glGetUniformLocation(post_processing_shader_.id(), "u_offsets_"), 9, (float*)offsets);
-	
-	const int edge_kernel[9] = {
-		-1, -1, -1,
-		-1,  8, -1,
-		-1, -1, -1
-	};
-	glUniform1iv(glGetUniformLocation(post_processing_shader_.id(), "u_edge_kernel_"), 9, edge_kernel);
+	post_processing_shader_.set_vec2("u_uv_scale_", uv_scale(), false);
 
-	const float blur_kernel[9] = {
-		1.0f / 16.0f, 2.0f / 16.0f, 1.0f / 16.0f,
-		2.0f / 16.0f, 4.0f / 16.0f, 2.0f / 16.0f,
-		1.0f / 16.0f, 2.0f / 16.0f, 1.0f / 16.0f
-	};
-	glUniform1fv(glGetUniformLocation(post_processing_shader_.id(), "u_blur_kernel_"), 9, blur_kernel);
+	// kernel offsets are derived from the render target's texel size at render time
+	// (see render()), so the kernel footprint no longer depends on viewport size
+	for (const auto *shader : { &blur_shader_, &edge_shader_, &invert_shader_ })
+	{
+		shader->use();
+		shader->set_int("u_scene_", 0, false);
+	}
 	
 	check_for_gl_errors();
 }
 
+void PostProcessor::set_msaa_samples(const SampleCount samples)
+{
+	ASSERT(samples == 0 || samples == 2 || samples == 4 || samples == 8,
+		"Unsupported MSAA sample count: " << samples);
+	requested_msaa_samples_ = samples;
+}
+
+void PostProcessor::set_render_size(const Dimension width, const Dimension height)
+{
+	if (width == width_ && height == height_)
+	{
+		return;
+	}
+
+	ScopedTimer timer{ "PostProcessor render target reallocation" };
+	width_ = width;
+	height_ = height;
+	update_scaled_size();
+	allocate_render_targets();
+}
+
+void PostProcessor::set_resolution_scale(const float scale)
+{
+	ASSERT(scale > 0.0f && scale <= 1.0f, "Resolution scale out of range: " << scale);
+	resolution_scale_ = scale;
+	update_scaled_size();
+}
+
+void PostProcessor::update_scaled_size()
+{
+	// round to whole pixels & never drop to an empty region
+	scaled_width_ = std::max(Dimension{ 1 }, static_cast<Dimension>(width_ * resolution_scale_ + 0.5f));
+	scaled_height_ = std::max(Dimension{ 1 }, static_cast<Dimension>(height_ * resolution_scale_ + 0.5f));
+}
+
 void PostProcessor::begin_render()
 {
-	glViewport(0, 0, width_, height_);
-	glBindFramebuffer(GL_FRAMEBUFFER, msfbo_);
+	if (msaa_samples_request_ != requested_msaa_samples_)
+	{
+		allocate_msaa_storage();
+	}
+
+	// the scene's projection is unchanged, so drawing into the scaled region just shrinks it
+	glViewport(0, 0, scaled_width_, scaled_height_);
+	glBindFramebuffer(GL_FRAMEBUFFER, scene_fbo());
 	glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
 	glClear(GL_COLOR_BUFFER_BIT);
 
@@ -91,9 +144,13 @@ void PostProcessor::begin_render()
 
 void PostProcessor::end_render()
 {
-	glBindFramebuffer(GL_READ_FRAMEBUFFER, msfbo_);
-	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, fbo_);
-	glBlitFramebuffer(0, 0, width_, height_, 0, 0, width_, height_, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+	// without MSAA the scene was drawn straight into texture_, so there's nothing to resolve
+	if (msaa_samples_ > 0)
+	{
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, msfbo_);
+		glBindFramebuffer(GL_DRAW_FRAMEBUFFER, fbo_);
+		glBlitFramebuffer(0, 0, scaled_width_, scaled_height_, 0, 0, scaled_width_, scaled_height_, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+	}
 
 	gl_property_resetter_.reset_fbo();
 	gl_property_resetter_.reset_viewport();
@@ -103,17 +160,44 @@ void PostProcessor::end_render()
 
 void PostProcessor::render(float time)
 {
+	const auto is_idle = idle();
+	record_frame_stats(is_idle);
+	if (is_idle)
+	{
+		// nothing to apply, so skip the passes & the composite draw entirely
+		present_scene();
+		return;
+	}
+
+	// the enabled stage runs as its own full-screen pass; stages which are
+	// off don't cost anything
+	next_pass_target_ = 0;
+	const Texture2D *scene = &texture_;
+	for (auto i = size_t{ 0 }; i < static_cast<size_t>(Stage::kNumStages); ++i)
+	{
+		const auto stage = static_cast<Stage>(i);
+		if (stage_enabled(stage))
+		{
+			scene = &run_stage(stage, *scene);
+		}
+	}
+	if (scene != &texture_)
+	{
+		gl_property_resetter_.reset_fbo();
+		gl_property_resetter_.reset_viewport();
+	}
+
 	// TODO(sasiala): I'm 90% sure there's a far better way to accomplish all of this.
 	// model & projection are used to allow this to behave as a window within a game.
 	// e.g. the game level could be displayed next to the list of levels instead of 
 	// as the background
 	auto model = glm::mat4(1.0f);
-	model = glm::translate(model, glm::vec3{ position_ + glm::vec2{width_ * .5, height_ * .5}, 0.0f });
+	model = glm::translate(model, glm::vec3{ position_ + glm::vec2{display_width_ * .5, display_height_ * .5}, 0.0f });
 	
 	// without the rotation, the game is displayed upside-down
 	model = glm::rotate(model, glm::radians(180.0f), glm::vec3{ 1.0f, 0.0f, 0.0f });
 
-	model = glm::scale(model, glm::vec3{ width_ *.5, height_ * .5, 1.0f });
+	model = glm::scale(model, glm::vec3{ display_width_ *.5, display_height_ * .5, 1.0f });
 
 	post_processing_shader_.use();
 	post_processing_shader_.set_mat4("u_model_", model, false);
@@ -121,14 +205,140 @@ void PostProcessor::render(float time)
 	post_processing_shader_.set_bool("u_confuse_", confuse_, false);
 	post_processing_shader_.set_bool("u_chaos_", chaos_, false);
 	post_processing_shader_.set_bool("u_shake_", shake_, false);
+	post_processing_shader_.set_vec2("u_uv_scale_", uv_scale(), false);
+
+	glActiveTexture(GL_TEXTURE0);
+	scene->bind();
+	glBindVertexArray(vao_);
+	glDrawArrays(GL_TRIANGLES, 0, 6);
+	glBindVertexArray(0);
+
+	check_for_gl_errors();
+}
+
+void PostProcessor::log_stats() const
+{
+	LOG("Post-processing: " << idle_frames_rendered_ << "/" << frames_rendered_
+		<< " frames took the idle fast path, ~" << (bytes_saved_total_ / 1024)
+		<< " KiB of framebuffer traffic saved (" << bytes_saved_last_frame_
+		<< " bytes last frame, " << msaa_samples_ << "x MSAA)");
+}
+
+bool PostProcessor::stage_enabled(const Stage stage) const
+{
+	// the effects are exclusive, as they were in the single effects shader:
+	// chaos wins over confuse, which wins over shake
+	switch (stage)
+	{
+	case Stage::kShakeBlur:
+		return shake_ && !chaos_ && !confuse_;
+	case Stage::kChaosEdge:
+		return chaos_;
+	case Stage::kConfuseInvert:
+		return confuse_ && !chaos_;
+	default:
+		ASSERT(false, "Unhandled post-processing stage");
+		return false;
+	}
+}
+
+const Texture2D &PostProcessor::run_stage(const Stage stage, const Texture2D &source)
+{
+	switch (stage)
+	{
+	case Stage::kShakeBlur:
+	{
+		// separable blur: horizontal pass, then vertical pass
+		blur_shader_.use();
+		blur_shader_.set_vec2("u_texel_step_", texel_size().x, 0.0f, false);
+		const auto &horizontal = run_pass(blur_shader_, source);
+
+		blur_shader_.use();
+		blur_shader_.set_vec2("u_texel_step_", 0.0f, texel_size().y, false);
+		return run_pass(blur_shader_, horizontal);
+	}
+	case Stage::kChaosEdge:
+		edge_shader_.use();
+		edge_shader_.set_vec2("u_texel_size_", texel_size(), false);
+		return run_pass(edge_shader_, source);
+	case Stage::kConfuseInvert:
+		return run_pass(invert_shader_, source);
+	default:
+		ASSERT(false, "Unhandled post-processing stage");
+		return source;
+	}
+}
+
+void PostProcessor::update_blit_destination()
+{
+	// the scene lands inside the viewport end_render() restores; position_ is
+	// measured from the top-left, the default framebuffer from the bottom-left
+	const auto screen = gl_property_resetter_.viewport();
+	blit_destination_[0] = screen.x_ + static_cast<int>(position_.x);
+	blit_destination_[1] = screen.y_ + screen.height_ - static_cast<int>(position_.y) - static_cast<int>(display_height_);
+	blit_destination_[2] = blit_destination_[0] + static_cast<int>(display_width_);
+	blit_destination_[3] = blit_destination_[1] + static_cast<int>(display_height_);
+}
+
+void PostProcessor::present_scene()
+{
+	const auto scaled = (display_width_ != scaled_width_ || display_height_ != scaled_height_);
+
+	// the scene is blitted from the resolved fbo_ rather than resolving msfbo_ straight to
+	// the screen: a multisampled resolve requires identical formats, & the default
+	// framebuffer's format isn't ours to choose
+	gl_property_resetter_.reset_fbo();
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo_);
+	glBlitFramebuffer(0, 0, scaled_width_, scaled_height_, 
+		blit_destination_[0], blit_destination_[1], blit_destination_[2], blit_destination_[3],
+		GL_COLOR_BUFFER_BIT, scaled ? GL_LINEAR : GL_NEAREST);
+	gl_property_resetter_.reset_fbo();
+
+	check_for_gl_errors();
+}
+
+void PostProcessor::record_frame_stats(const bool idle)
+{
+	++frames_rendered_;
+	bytes_saved_last_frame_ = 0;
+	if (!idle)
+	{
+		return;
+	}
+	++idle_frames_rendered_;
+
+	// the composite samples the scene once & blends into the screen (read + write);
+	// the blit reads the scene once & writes the screen once
+	const auto pixels = static_cast<ByteCount>(display_width_) * display_height_;
+	const auto composite_bytes = 3 * pixels * kBytesPerPixel;
+	const auto blit_bytes = 2 * pixels * kBytesPerPixel;
+	bytes_saved_last_frame_ = composite_bytes - blit_bytes;
+	bytes_saved_total_ += bytes_saved_last_frame_;
+}
+
+const Texture2D &PostProcessor::run_pass(const Shader &shader, const Texture2D &source)
+{
+	const auto target = next_pass_target_;
+	next_pass_target_ = (next_pass_target_ + 1) % kNumPassTargets;
+	ASSERT(&pass_textures_[target] != &source, "Pass would sample its own render target");
+
+	glBindFramebuffer(GL_FRAMEBUFFER, pass_fbos_[target]);
+	glViewport(0, 0, scaled_width_, scaled_height_);
 
+	// keep the kernels' taps inside the region the scene was drawn into
+	const auto uv_max = uv_scale() - 0.5f * texel_size();
+	shader.use();
+	shader.set_vec2("u_uv_scale_", uv_scale(), false);
+	shader.set_vec2("u_uv_max_", uv_max, true);
 	glActiveTexture(GL_TEXTURE0);
-	texture_.bind();
+	source.bind();
 	glBindVertexArray(vao_);
 	glDrawArrays(GL_TRIANGLES, 0, 6);
 	glBindVertexArray(0);
 
 	check_for_gl_errors();
+
+	return pass_textures_[target];
 }
 
 void PostProcessor::initialize_render_data()
@@ -159,4 +369,56 @@ void PostProcessor::initialize_render_data()
 	check_for_gl_errors();
 }
 
+void PostProcessor::allocate_render_targets()
+{
+	// textures stay attached to their FBOs, so regenerating their storage is enough
+	texture_.generate(width_, height_, nullptr, true);
+	for (auto &pass_texture : pass_textures_)
+	{
+		pass_texture.generate(width_, height_, nullptr, true);
+	}
+	allocate_msaa_storage();
+}
+
+void PostProcessor::allocate_msaa_storage()
+{
+	GLint max_samples{ 0 };
+	glGetIntegerv(GL_MAX_SAMPLES, &max_samples);
+
+	msaa_samples_request_ = requested_msaa_samples_;
+	msaa_samples_ = std::min(requested_msaa_samples_, static_cast<SampleCount>(max_samples));
+	if (msaa_samples_ != requested_msaa_samples_)
+	{
+		LOG("Requested " << requested_msaa_samples_ << "x MSAA, using " << msaa_samples_ << "x");
+	}
+
+	if (msaa_samples_ > 0)
+	{
+		glBindFramebuffer(GL_FRAMEBUFFER, msfbo_);
+		glBindRenderbuffer(GL_RENDERBUFFER, rbo_);
+		glRenderbufferStorageMultisample(GL_RENDERBUFFER, msaa_samples_, GL_RGB, width_, height_); // allocate storage for render buffer
+		glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, rbo_);
+		ASSERT(glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE, "Failed to initialize MSFBO");
+		glBindRenderbuffer(GL_RENDERBUFFER, 0);
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	}
+
+	check_for_gl_errors();
+}
+
+void PostProcessor::initialize_pass_targets()
+{
+	glGenFramebuffers(kNumPassTargets, pass_fbos_);
+	for (auto i = size_t{ 0 }; i < kNumPassTargets; ++i)
+	{
+		glBindFramebuffer(GL_FRAMEBUFFER, pass_fbos_[i]);
+		pass_textures_[i].generate(width_, height_, nullptr, true);
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, pass_textures_[i].id(), 0);
+		ASSERT(glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE, "Failed to initialize effect pass FBO");
+	}
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+	check_for_gl_errors();
+}
+
 } // namespace util
\ No newline at end of file
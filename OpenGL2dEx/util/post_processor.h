@@ -13,8 +13,14 @@ class IResetGlProperties;
 
 class PostProcessor {
 public:
+	using SampleCount = unsigned int;
+	using ByteCount = unsigned long long;
+
 	PostProcessor(const IResetGlProperties& gl_property_resetter,
 				  const Shader       &post_processing_shader,
+				  const Shader       &blur_shader,
+				  const Shader       &edge_shader,
+				  const Shader       &invert_shader,
 				  glm::vec2          position,
 				  unsigned int       width,
 				  unsigned int       height,
@@ -24,6 +30,45 @@ public:
 	void end_render();
 	void render(float time);
 
+	// MSAA sample count used for the scene (0, 2, 4 or 8); takes effect on the next
+	// begin_render() and is clamped to what the driver supports
+	static void set_msaa_samples(SampleCount samples);
+
+	static SampleCount msaa_samples()
+	{
+		return requested_msaa_samples_;
+	}
+
+	// true when no effect is active, i.e. the scene is blitted straight to the screen
+	// instead of going through the effect passes & composite
+	bool idle() const
+	{
+		return !confuse_ && !chaos_ && !shake_;
+	}
+
+	// estimated framebuffer traffic avoided by the last frame (0 if it wasn't idle)
+	ByteCount bytes_saved_last_frame() const
+	{
+		return bytes_saved_last_frame_;
+	}
+
+	ByteCount bytes_saved_total() const
+	{
+		return bytes_saved_total_;
+	}
+
+	size_t frames_rendered() const
+	{
+		return frames_rendered_;
+	}
+
+	size_t idle_frames_rendered() const
+	{
+		return idle_frames_rendered_;
+	}
+
+	void log_stats() const;
+
 	bool confuse() const
 	{
 		return confuse_;
@@ -59,36 +104,138 @@ public:
 		confuse_ = chaos_ = shake_ = false;
 	}
 
-	void set_size(const Dimension width, const Dimension height)
+	// size the scene is displayed at; only changes the composite transform, so this
+	// is cheap enough to call every frame (e.g. while animating the viewport)
+	void set_display_size(const Dimension width, const Dimension height)
+	{
+		display_width_ = width;
+		display_height_ = height;
+		update_blit_destination();
+	}
+
+	// size the scene is rendered at; reallocates every render target, so this
+	// should only be called when the framebuffer itself changes size
+	void set_render_size(Dimension width, Dimension height);
+
+	Dimension render_width() const
+	{
+		return width_;
+	}
+
+	Dimension render_height() const
 	{
-		width_ = width;
-		height_ = height;
-		texture_.generate(width, height, nullptr, true);
+		return height_;
+	}
+
+	// fraction of the render size the scene is actually drawn at (upscaled when
+	// composited); the render targets keep their size, only a sub-region is used
+	void set_resolution_scale(float scale);
+
+	float resolution_scale() const
+	{
+		return resolution_scale_;
 	}
 
 	void set_position(const glm::vec2 &position)
 	{
 		position_ = position;
+		update_blit_destination();
 	}
 
 private:
+	enum class Stage {
+		kShakeBlur,
+		kChaosEdge,
+		kConfuseInvert,
+		kNumStages,
+		kUnknown,
+	};
+	bool stage_enabled(Stage stage) const;
+	const Texture2D &run_stage(Stage stage, const Texture2D &source);
+
 	void initialize_render_data();
+	void initialize_pass_targets();
+	void allocate_render_targets();
+	void allocate_msaa_storage();
+
+	// framebuffer the scene is drawn into; the texture-backed FBO when MSAA is off
+	unsigned int scene_fbo() const
+	{
+		return msaa_samples_ > 0 ? msfbo_ : fbo_;
+	}
+
+	// blits the (resolved) scene directly into position_ on the default framebuffer
+	void present_scene();
+	// works out where present_scene() blits to, whenever the position or display size changes
+	void update_blit_destination();
+	void record_frame_stats(bool idle);
+
+	// draws a full-screen quad w/ the given (already configured) shader, sampling
+	// source and writing into the next ping-pong target; returns that target
+	const Texture2D &run_pass(const Shader &shader, const Texture2D &source);
+
+	glm::vec2 texel_size() const
+	{
+		return{ 1.0f / width_, 1.0f / height_ };
+	}
+
+	Dimension scaled_width() const
+	{
+		return scaled_width_;
+	}
+
+	Dimension scaled_height() const
+	{
+		return scaled_height_;
+	}
+
+	// portion of the render targets' uv space covered by the scene
+	glm::vec2 uv_scale() const
+	{
+		return{ static_cast<float>(scaled_width_) / width_, static_cast<float>(scaled_height_) / height_ };
+	}
+
+	void update_scaled_size();
 
 	const IResetGlProperties& gl_property_resetter_;
 	Shader post_processing_shader_;
+	Shader blur_shader_;
+	Shader edge_shader_;
+	Shader invert_shader_;
 	Texture2D texture_;
 	glm::vec2 position_;
-	Dimension width_;
+	Dimension width_; // render target size
 	Dimension height_;
+	Dimension display_width_;
+	Dimension display_height_;
+	float resolution_scale_;
+	Dimension scaled_width_;
+	Dimension scaled_height_;
+	int blit_destination_[4]; // x0, y0, x1, y1 on the default framebuffer
 
 	bool confuse_;
 	bool chaos_;
 	bool shake_;
 
+	static SampleCount requested_msaa_samples_;
+	SampleCount msaa_samples_; // samples currently allocated for rbo_ (0 == no MSAA)
+	SampleCount msaa_samples_request_; // request msaa_samples_ was allocated for
+
 	unsigned int msfbo_; // multisampled FBO
 	unsigned int fbo_;
 	unsigned int rbo_;
 	unsigned int vao_;
+
+	// ping-pong targets for effect passes; a pass never samples the target it writes to
+	static constexpr size_t kNumPassTargets{ 2 };
+	unsigned int pass_fbos_[kNumPassTargets];
+	Texture2D    pass_textures_[kNumPassTargets];
+	size_t       next_pass_target_;
+
+	ByteCount bytes_saved_last_frame_;
+	ByteCount bytes_saved_total_;
+	size_t frames_rendered_;
+	size_t idle_frames_rendered_;
 };
 
 } // namespace util
@@ -1,81 +1,100 @@
 #ifndef POWER_UP_H
 #define POWER_UP_H
 
-#include "game_object.h"
+#include "logging.h"
 
 #include <glm/glm.hpp>
 
+#include <cstddef>
+
 namespace util {
 
-class PowerUp : public GameObject
-{
-public:
-	// TODO(sasiala): use constants in constructor, but these don't get initialized early enough..?
-	const glm::vec2 kSize = glm::vec2( 60.0f, 20.0f );
-	const glm::vec2 kVelocity = glm::vec2( 0.0f, 150.0f );
+// A power-up falling from a destroyed brick.  Plain data; everything else about
+// a power-up (look, effect, duration) depends only on its type, so it's looked
+// up by type rather than stored in every power-up (see GameViewport)
+struct PowerUp {
 	typedef unsigned int Type;
 
-	PowerUp(const Type type, const glm::vec3 &color, const float duration,
-		const glm::vec2 &position, const Texture2D texture)
-		: GameObject(position, glm::vec2(60.0f, 20.0f), texture, color , glm::vec2(0.0f, 150.0f))
-		, type_{ type }
-		, duration_{ duration }
-		, activated_{ false }
-	{
-	}
+	Type      type_;
+	glm::vec2 position_;
+};
 
-	PowerUp(const PowerUp &other)
-		: GameObject{ other }
-		, type_{ other.type_ }
-		, duration_{ other.duration_ }
-		, activated_{ other.activated_ }
-	{
-	}
+// Fixed-capacity storage for falling power-ups.  Freed slots are kept on a
+// free list, so spawning & releasing are O(1) & never allocate.  Slots don't
+// move, so a slot index stays valid until that slot is released
+class PowerUpPool {
+public:
+	static constexpr size_t kCapacity{ 64 };
 
-	util::PowerUp &operator=(const util::PowerUp &rhs)
+	PowerUpPool()
+		: power_ups_{}
+		, next_free_{}
+		, in_use_{}
+		, first_free_{ 0 }
 	{
-		GameObject::operator=(rhs);
-		type_ = rhs.type_;
-		duration_ = rhs.duration_;
-		activated_ = rhs.activated_;
-		return *this;
+		clear();
 	}
 
-	Type type() const
+	// false (& nothing spawned) if every slot is taken
+	bool spawn(const PowerUp::Type type, const glm::vec2 &position)
 	{
-		return type_;
+		if (first_free_ == kNoSlot)
+		{
+			return false;
+		}
+
+		const auto slot = first_free_;
+		first_free_ = next_free_[slot];
+		power_ups_[slot] = PowerUp{ type, position };
+		in_use_[slot] = true;
+		return true;
 	}
 
-	void set_type(const Type type)
+	void release(const size_t slot)
 	{
-		type_ = type;
+		ASSERT(slot < kCapacity && in_use_[slot], "Power-up slot isn't in use");
+
+		in_use_[slot] = false;
+		next_free_[slot] = first_free_;
+		first_free_ = slot;
 	}
 
-	float duration() const
+	void clear()
 	{
-		return duration_;
+		for (size_t slot = 0; slot < kCapacity; ++slot)
+		{
+			in_use_[slot] = false;
+			next_free_[slot] = slot + 1;
+		}
+		first_free_ = 0;
 	}
 
-	void set_duration(const float duration)
+	bool in_use(const size_t slot) const
 	{
-		duration_ = duration;
+		ASSERT(slot < kCapacity, "Power-up slot out of bounds");
+		return in_use_[slot];
 	}
 
-	bool activated() const
+	PowerUp &operator[](const size_t slot)
 	{
-		return activated_;
+		ASSERT(in_use(slot), "Power-up slot isn't in use");
+		return power_ups_[slot];
 	}
 
-	void set_activated(const bool activated)
+	const PowerUp &operator[](const size_t slot) const
 	{
-		activated_ = activated;
+		ASSERT(in_use(slot), "Power-up slot isn't in use");
+		return power_ups_[slot];
 	}
 
 private:
-	Type  type_;
-	float duration_;
-	bool  activated_;
-};
+	static constexpr size_t kNoSlot{ kCapacity }; // end of the free list
+
+	PowerUp power_ups_[kCapacity];
+	size_t  next_free_[kCapacity]; // only meaningful for free slots
+	bool    in_use_[kCapacity];
+	size_t  first_free_;
+}; // class PowerUpPool
 
 } // namespace util
 
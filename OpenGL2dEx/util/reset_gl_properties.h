@@ -8,6 +8,14 @@ namespace util {
 // the parent
 class IResetGlProperties {
 public:
+	// in pixels, from the bottom-left of the default framebuffer
+	struct Viewport {
+		int x_;
+		int y_;
+		int width_;
+		int height_;
+	};
+
 	IResetGlProperties()
 	{
 	}
@@ -21,9 +29,16 @@ public:
 	{
 		reset_viewport_impl();
 	}
+
+	// the viewport reset_viewport() restores, so it can be used w/o querying GL
+	Viewport viewport() const
+	{
+		return viewport_impl();
+	}
 private:
 	virtual void reset_fbo_impl() const = 0;
 	virtual void reset_viewport_impl() const = 0;
+	virtual Viewport viewport_impl() const = 0;
 
 }; // class IResetGlProperties
 
@@ -0,0 +1,141 @@
+#include "resolution_controller.h"
+
+#include "gl_debug.h"
+#include "logging.h"
+
+#include <glad/glad.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace util {
+
+	constexpr float ResolutionController::kMinScale;
+	constexpr float ResolutionController::kMaxScale;
+
+	// off by default: the scene is cheap enough that the GPU time rarely nears the
+	// budget, & a lowered resolution is visible; opt in w/ --dynamic-resolution
+	bool ResolutionController::enabled_{ false };
+	// the viewport shares the frame w/ the menus & swap, so it only gets part of 16.6ms
+	ResolutionController::Milliseconds ResolutionController::frame_budget_{ 10.0f };
+
+	ResolutionController::ResolutionController()
+		: queries_{}
+		, query_pending_{}
+		, current_query_{ 0 }
+		, measuring_{ false }
+		, average_gpu_time_{ 0.0f }
+		, has_average_{ false }
+		, scale_{ kMaxScale }
+		, frames_since_change_{ 0 }
+	{
+		glGenQueries(kNumQueries, queries_);
+		check_for_gl_errors();
+	}
+
+	ResolutionController::~ResolutionController()
+	{
+		glDeleteQueries(kNumQueries, queries_);
+	}
+
+	void ResolutionController::begin_frame()
+	{
+		if (!enabled_)
+		{
+			scale_ = kMaxScale;
+			has_average_ = false;
+			measuring_ = false;
+			return;
+		}
+
+		collect_results();
+
+		// if the GPU is still kNumQueries frames behind, skip measuring this frame
+		// rather than stalling on the oldest query
+		measuring_ = !query_pending_[current_query_];
+		if (measuring_)
+		{
+			glBeginQuery(GL_TIME_ELAPSED, queries_[current_query_]);
+		}
+	}
+
+	void ResolutionController::end_frame()
+	{
+		if (!measuring_)
+		{
+			return;
+		}
+
+		glEndQuery(GL_TIME_ELAPSED);
+		query_pending_[current_query_] = true;
+		current_query_ = (current_query_ + 1) % kNumQueries;
+		measuring_ = false;
+
+		check_for_gl_errors();
+	}
+
+	void ResolutionController::collect_results()
+	{
+		// current_query_ is the next slot to be reused, i.e. the oldest, so this
+		// walks the queries in the order they were submitted; they complete in
+		// that order too, so once one isn't ready the newer ones aren't either
+		for (auto i = size_t{ 0 }; i < kNumQueries; ++i)
+		{
+			const auto query = (current_query_ + i) % kNumQueries;
+			if (!query_pending_[query])
+			{
+				continue;
+			}
+
+			GLint available{ GL_FALSE };
+			glGetQueryObjectiv(queries_[query], GL_QUERY_RESULT_AVAILABLE, &available);
+			if (available == GL_FALSE)
+			{
+				break;
+			}
+
+			GLuint64 elapsed_ns{ 0 };
+			glGetQueryObjectui64v(queries_[query], GL_QUERY_RESULT, &elapsed_ns);
+			query_pending_[query] = false;
+			update_scale(static_cast<Milliseconds>(elapsed_ns) / 1.0e6f);
+		}
+	}
+
+	void ResolutionController::update_scale(const Milliseconds gpu_time)
+	{
+		average_gpu_time_ = has_average_
+			? average_gpu_time_ + kSmoothing * (gpu_time - average_gpu_time_)
+			: gpu_time;
+		has_average_ = true;
+
+		if (++frames_since_change_ < kSettleFrames)
+		{
+			return;
+		}
+
+		const auto over_budget = average_gpu_time_ > kUpperThreshold * frame_budget_;
+		const auto under_budget = average_gpu_time_ < kLowerThreshold * frame_budget_ && scale_ < kMaxScale;
+		if (!over_budget && !under_budget)
+		{
+			return;
+		}
+
+		// time ~ scale^2, so the scale which would hit the target is scale * sqrt(target / time)
+		const auto target_time = kHeadroom * frame_budget_;
+		auto new_scale = scale_ * std::sqrt(target_time / std::max(average_gpu_time_, 0.001f));
+		new_scale = std::max(scale_ - kMaxStep, std::min(scale_ + kMaxStep, new_scale));
+		new_scale = std::max(kMinScale, std::min(kMaxScale, new_scale));
+		if (std::abs(new_scale - scale_) < 0.01f)
+		{
+			return;
+		}
+
+		LOG("Resolution scale " << scale_ << " -> " << new_scale
+			<< " (GPU " << average_gpu_time_ << "ms, budget " << frame_budget_ << "ms)");
+		scale_ = new_scale;
+		frames_since_change_ = 0;
+		// older samples were taken at the previous scale
+		has_average_ = false;
+	}
+
+} // namespace util
\ No newline at end of file
@@ -0,0 +1,90 @@
+#ifndef RESOLUTION_CONTROLLER_H
+#define RESOLUTION_CONTROLLER_H
+
+#include <cstddef>
+
+namespace util {
+
+// Picks a resolution scale for a render pass so that the pass's GPU time stays
+// within a budget.  The time is measured w/ GL_TIME_ELAPSED queries bracketing
+// begin_frame()/end_frame(); results are read a few frames late so the CPU never
+// waits on the GPU.
+//
+// GPU time is assumed to grow w/ the pixel count (scale^2).  The scale only moves
+// once the smoothed time leaves the band [kLowerThreshold, kUpperThreshold] * budget,
+// & then waits kSettleFrames before moving again, so it doesn't oscillate.
+class ResolutionController {
+public:
+	using Milliseconds = float;
+
+	static constexpr float kMinScale{ 0.5f };
+	static constexpr float kMaxScale{ 1.0f };
+
+	ResolutionController();
+	~ResolutionController();
+
+	ResolutionController(const ResolutionController&) = delete;
+	ResolutionController &operator=(const ResolutionController&) = delete;
+
+	void begin_frame();
+	void end_frame();
+
+	float scale() const
+	{
+		return scale_;
+	}
+
+	Milliseconds average_gpu_time() const
+	{
+		return average_gpu_time_;
+	}
+
+	static void set_enabled(bool enabled)
+	{
+		enabled_ = enabled;
+	}
+
+	static bool enabled()
+	{
+		return enabled_;
+	}
+
+	static void set_frame_budget(Milliseconds budget)
+	{
+		frame_budget_ = budget;
+	}
+
+	static Milliseconds frame_budget()
+	{
+		return frame_budget_;
+	}
+
+private:
+	void collect_results();
+	void update_scale(Milliseconds gpu_time);
+
+	static constexpr size_t kNumQueries{ 3 };
+	static constexpr float kSmoothing{ 0.1f };
+	static constexpr float kUpperThreshold{ 1.0f };
+	static constexpr float kLowerThreshold{ 0.7f };
+	static constexpr float kHeadroom{ 0.9f }; // aim slightly under budget
+	static constexpr float kMaxStep{ 0.1f };
+	static constexpr size_t kSettleFrames{ 30 };
+
+	static bool enabled_;
+	static Milliseconds frame_budget_;
+
+	unsigned int queries_[kNumQueries];
+	bool         query_pending_[kNumQueries];
+	size_t       current_query_;
+	bool         measuring_;
+
+	Milliseconds average_gpu_time_;
+	bool         has_average_;
+	float        scale_;
+	size_t       frames_since_change_;
+}; // class ResolutionController
+
+} // namespace util
+
+#endif // RESOLUTION_CONTROLLER_H
\ No newline at end of file
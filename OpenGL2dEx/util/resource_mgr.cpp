@@ -9,8 +9,7 @@ namespace util {
 	std::map<ResourceManager::ShaderId, Shader> ResourceManager::shaders_{};
 	ResourceManager::ShaderId					ResourceManager::next_shader_id_{ 0 };
 
-	std::map<ResourceManager::Texture2DId, Texture2D> ResourceManager::textures_{};
-	ResourceManager::Texture2DId					  ResourceManager::next_texture_id_{0};
+	std::vector<Texture2D> ResourceManager::textures_{};
 
 	std::map<ResourceManager::FontId, TextRenderer> ResourceManager::fonts_{};
 	ResourceManager::FontId							ResourceManager::next_font_id_{ 0 };
@@ -52,14 +51,21 @@ namespace {
 
 	ResourceManager::Texture2DId ResourceManager::load_texture(const char *file, bool alpha)
 	{
-		const auto texture_id = next_texture_id_;
-		textures_[next_texture_id_++] = load_texture_from_file(file, alpha);
+		const auto texture_id = static_cast<Texture2DId>(textures_.size());
+		textures_.push_back(load_texture_from_file(file, alpha));
+		return texture_id;
+	}
+
+	ResourceManager::Texture2DId ResourceManager::add_texture(const Texture2D &texture)
+	{
+		const auto texture_id = static_cast<Texture2DId>(textures_.size());
+		textures_.push_back(texture);
 		return texture_id;
 	}
 
 	const Texture2D &ResourceManager::get_texture(Texture2DId texture_id)
 	{
-		ASSERT(textures_.find(texture_id) != textures_.end(), "Texture ID not found");
+		ASSERT(texture_id < textures_.size(), "Texture ID not found");
 		return textures_[texture_id];
 	}
 
@@ -84,7 +90,6 @@ namespace {
 	void ResourceManager::clear()
 	{
 		next_shader_id_ = 0;
-		next_texture_id_ = 0;
 
 		shaders_.clear();
 		textures_.clear();
@@ -4,14 +4,18 @@
 #include "shader.h"
 #include "texture_2d.h"
 #include "text_renderer.h"
+
+#include <cstdint>
 #include <map>
+#include <vector>
 
 namespace util {
 
 class ResourceManager {
 public:
 	using ShaderId = unsigned int;
-	using Texture2DId = unsigned int;
+	// a compact handle for objects to hold; the renderer resolves it
+	using Texture2DId = uint32_t;
 	using FontId = unsigned int;
 
 	// load/get shaders
@@ -20,6 +24,8 @@ public:
 	
 	// 2D Textures
 	static Texture2DId load_texture(const char *file, bool alpha);
+	// for textures made at runtime, e.g. render targets, so the renderer can draw them
+	static Texture2DId add_texture(const Texture2D &texture);
 	static const Texture2D   &get_texture(Texture2DId texture_id);
 
 	// Fonts
@@ -40,8 +46,7 @@ private:
 	static std::map<ShaderId, Shader> shaders_;
 	static ShaderId                   next_shader_id_;
 
-	static std::map<Texture2DId, Texture2D> textures_;
-	static Texture2DId                      next_texture_id_;
+	static std::vector<Texture2D> textures_; // by id; ids are handed out in order
 
 	static std::map<FontId, TextRenderer> fonts_;
 	static FontId                         next_font_id_;
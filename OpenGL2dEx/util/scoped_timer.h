@@ -0,0 +1,43 @@
+#ifndef SCOPED_TIMER_H
+#define SCOPED_TIMER_H
+
+#include "logging.h"
+
+#include <chrono>
+
+namespace util {
+
+// Logs the wall-clock time spent between construction & destruction.
+// Intended for profiling infrequent paths (resizes, loads); don't leave
+// one in a per-frame path, since every measurement is written to the log
+class ScopedTimer {
+public:
+	using Clock = std::chrono::steady_clock;
+
+	explicit ScopedTimer(const char *label)
+		: label_{ label }
+		, start_{ Clock::now() }
+	{
+	}
+
+	ScopedTimer(const ScopedTimer&) = delete;
+	ScopedTimer &operator=(const ScopedTimer&) = delete;
+
+	~ScopedTimer()
+	{
+		LOG(label_ << " took " << elapsed_microseconds() << "us");
+	}
+
+	long long elapsed_microseconds() const
+	{
+		return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start_).count();
+	}
+
+private:
+	const char        *label_;
+	Clock::time_point start_;
+}; // class ScopedTimer
+
+} // namespace util
+
+#endif // SCOPED_TIMER_H
\ No newline at end of file
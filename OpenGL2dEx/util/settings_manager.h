@@ -3,6 +3,8 @@
 
 #include "audio_manager.h"
 #include "game.h"
+#include "post_processor.h"
+#include "resolution_controller.h"
 
 namespace util {
 
@@ -10,6 +12,8 @@ class SettingsManager{
 public:
 	using VolumePercentage = AudioManager::VolumePercentage;
 	using GameSpeedMultiplier = Game::GameSpeedMultiplier;
+	using MsaaSampleCount = PostProcessor::SampleCount;
+	using Milliseconds = ResolutionController::Milliseconds;
 
 	static void set_volume(VolumePercentage volume)
 	{
@@ -31,6 +35,59 @@ public:
 		return Game::game_speed_multiplier();
 	}
 
+	static void set_msaa_samples(MsaaSampleCount samples)
+	{
+		PostProcessor::set_msaa_samples(samples);
+	}
+
+	static MsaaSampleCount msaa_samples()
+	{
+		return PostProcessor::msaa_samples();
+	}
+
+	static void set_dynamic_resolution(bool enabled)
+	{
+		ResolutionController::set_enabled(enabled);
+	}
+
+	static bool dynamic_resolution()
+	{
+		return ResolutionController::enabled();
+	}
+
+	// GPU time the game viewport may spend per frame before its resolution is lowered
+	static void set_viewport_frame_budget(Milliseconds budget)
+	{
+		ResolutionController::set_frame_budget(budget);
+	}
+
+	static Milliseconds viewport_frame_budget()
+	{
+		return ResolutionController::frame_budget();
+	}
+
+	// polls input again right before rendering & moves the paddle then
+	static void set_low_latency_input(bool enabled)
+	{
+		Game::set_low_latency_input(enabled);
+	}
+
+	static bool low_latency_input()
+	{
+		return Game::low_latency_input();
+	}
+
+	// extra balls in play from the start of every life (stress/showcase mode)
+	static void set_extra_balls(size_t count)
+	{
+		GameViewport::set_extra_balls(count);
+	}
+
+	static size_t extra_balls()
+	{
+		return GameViewport::extra_balls();
+	}
+
 private:
 	// singleton
 	SettingsManager()
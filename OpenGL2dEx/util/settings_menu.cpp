@@ -46,12 +46,13 @@ namespace {
 		auto create_label = [loaded_width, loaded_height](const char *str, size_t index) {
 			return MenuObject{ make_label(str, index, loaded_width, loaded_height) };
 		};
-		auto make_list = [create_label, loaded_width, loaded_height]() -> MenuType::OptionList
+		auto add_options = [create_label](MenuList &menu_list)
 		{
-			static MenuType::OptionList::ObjectArray arr{ create_label("A", 0), create_label("B", 1), create_label("C", 2) };
-			return{ arr };
+			menu_list.emplace_back(create_label("A", 0));
+			menu_list.emplace_back(create_label("B", 1));
+			menu_list.emplace_back(create_label("C", 2));
 		};
-		menu_.update_info("MAIN MENU", "SETTINGS TEST", true, make_list(), 0);
+		menu_.update_info("MAIN MENU", "SETTINGS TEST", true, add_options, 0);
 		menu_.activate();
 	}
 
@@ -70,24 +71,24 @@ namespace {
 		menu_.render(parent_sprite_renderer);
 	}
 
-	void SettingsMenu::set_key_impl(KeyId key_id, bool val)
+	void SettingsMenu::process_input_impl(const InputState &input, Time dt)
 	{
 		if (!is_active())
 		{
 			return;
 		}
 
-		menu_.set_key(key_id, val);
+		menu_.process_input(input, dt);
 	}
 
-	void SettingsMenu::process_input_impl(Time dt)
+	bool SettingsMenu::is_dirty_impl() const
 	{
-		if (!is_active())
-		{
-			return;
-		}
+		return menu_.is_dirty();
+	}
 
-		menu_.process_input(dt);
+	void SettingsMenu::clear_dirty_impl()
+	{
+		menu_.clear_dirty();
 	}
 
 	void SettingsMenu::handle_menu_option_highlight_impl(const MenuIndex /*index*/)
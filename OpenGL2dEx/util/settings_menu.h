@@ -98,9 +98,9 @@ private:
 	void activate_impl() override;
 	void deactivate_impl() override;
 	void render_impl(Optional<SpriteRenderer*> parent_sprite_renderer) override;
-	void set_key_impl(KeyId key_id, bool val) override;
-	// TODO(sasiala): improve event handling
-	void process_input_impl(Time dt) override;
+	void process_input_impl(const InputState &input, Time dt) override;
+	bool is_dirty_impl() const override;
+	void clear_dirty_impl() override;
 
 	void handle_menu_option_highlight_impl(const MenuIndex index) override;
 	void handle_menu_option_acceptance_impl(const MenuIndex /*index*/) override;
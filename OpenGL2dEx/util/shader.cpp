@@ -1,7 +1,10 @@
 #include "shader.h"
 
+#include "array_helpers.h"
 #include "logging.h"
 #include "gl_debug.h"
+#include "shader_cache.h"
+#include <chrono>
 #include <fstream>
 #include <sstream>
 
@@ -88,6 +91,8 @@ unsigned int compile_shader(const char * const shader_code, int shader_type)
 
 Shader::Shader(const char *vertex_path, const char *fragment_path, Optional<const char *> geometry_path)
 {
+	const auto load_start = std::chrono::steady_clock::now();
+
 	std::string vertex_code{ "" };
 	std::string geometry_code{ "" };
 	std::string fragment_code{ "" };
@@ -99,30 +104,47 @@ Shader::Shader(const char *vertex_path, const char *fragment_path, Optional<cons
 	}
 	fragment_code = shader_code(fragment_path);
 
+	const char *sources[] = { vertex_code.c_str(), geometry_path ? geometry_code.c_str() : nullptr, fragment_code.c_str() };
+	const auto cache_key = ShaderCache::key(sources, count_of(sources));
+
+	id_ = glCreateProgram();
+	const auto from_cache = ShaderCache::load(id_, cache_key);
+	if (!from_cache)
+	{
+		compile_and_link(vertex_code.c_str(), geometry_path ? geometry_code.c_str() : nullptr, fragment_code.c_str());
+		ShaderCache::store(id_, cache_key);
+	}
+
+	const auto load_time = std::chrono::steady_clock::now() - load_start;
+	ShaderCache::record_load_time(from_cache, std::chrono::duration_cast<std::chrono::microseconds>(load_time).count());
+}
+
+void Shader::compile_and_link(const char *vertex_code, const char *geometry_code, const char *fragment_code)
+{
 	// compile shader
 	unsigned int vertex_shader_id{}, geometry_shader_id{}, fragment_shader_id{};
-	vertex_shader_id = compile_shader(vertex_code.c_str(), GL_VERTEX_SHADER);
-	if (geometry_path)
+	vertex_shader_id = compile_shader(vertex_code, GL_VERTEX_SHADER);
+	if (geometry_code)
 	{
-		geometry_shader_id = compile_shader(geometry_code.c_str(), GL_GEOMETRY_SHADER);
+		geometry_shader_id = compile_shader(geometry_code, GL_GEOMETRY_SHADER);
 	}
-	fragment_shader_id = compile_shader(fragment_code.c_str(), GL_FRAGMENT_SHADER);
+	fragment_shader_id = compile_shader(fragment_code, GL_FRAGMENT_SHADER);
 
-	id_ = glCreateProgram();
 	glAttachShader(id_, vertex_shader_id);
-	if (geometry_path)
+	if (geometry_code)
 	{
 		glAttachShader(id_, geometry_shader_id);
 	}
 	glAttachShader(id_, fragment_shader_id);
 
+	ShaderCache::prepare_for_link(id_);
 	glLinkProgram(id_);
 
 	check_compile_errors(id_, CompileErrorCheckType::kLinker, {});
 
 	// delete the shaders since they're already linked in
 	glDeleteShader(vertex_shader_id);
-	if (geometry_path)
+	if (geometry_code)
 	{
 		glDeleteShader(geometry_shader_id);
 	}
@@ -136,14 +158,14 @@ void Shader::use() const
 }
 
 namespace {
-	unsigned int uniform_location(const unsigned int id, const std::string &name, bool allow_invalid)
+	unsigned int uniform_location(const unsigned int id, const char *name, bool allow_invalid)
 	{
-		const auto uniform_loc = glGetUniformLocation(id, name.c_str());
+		const auto uniform_loc = glGetUniformLocation(id, name);
 		if (!allow_invalid)
 		{
 			// TODO(sasiala): improve logging (add var name)
 			static constexpr int kGetUniformLocationError{ -1 };
-			ASSERT(uniform_loc != kGetUniformLocationError, "Error: variable not found.  Var name: " + name);
+			ASSERT(uniform_loc != kGetUniformLocationError, "Error: variable not found.  Var name: " + std::string{ name });
 		}
 
 		return uniform_loc;
@@ -151,73 +173,73 @@ namespace {
 }
 
 
-void Shader::set_bool(const std::string &name, const bool value, const bool allow_invalid) const
+void Shader::set_bool(const char *name, const bool value, const bool allow_invalid) const
 {
 	glUniform1i(uniform_location(id_, name, allow_invalid), static_cast<int>(value));
 	check_for_gl_errors();
 }
 
-void Shader::set_int(const std::string &name, const int value, const bool allow_invalid) const
+void Shader::set_int(const char *name, const int value, const bool allow_invalid) const
 {
 	glUniform1i(uniform_location(id_, name, allow_invalid), value);
 	check_for_gl_errors();
 }
 
-void Shader::set_float(const std::string &name, const float value, const bool allow_invalid) const
+void Shader::set_float(const char *name, const float value, const bool allow_invalid) const
 {
 	glUniform1f(uniform_location(id_, name, allow_invalid), value);
 	check_for_gl_errors();
 }
 
-void Shader::set_vec2(const std::string &name, const float val_1, const float val_2, const bool allow_Invalid) const
+void Shader::set_vec2(const char *name, const float val_1, const float val_2, const bool allow_Invalid) const
 {
 	glUniform2f(uniform_location(id_, name, allow_Invalid), val_1, val_2);
 	check_for_gl_errors();
 }
 
-void Shader::set_vec2(const std::string &name, const glm::vec2 &vec, const bool allow_invalid) const
+void Shader::set_vec2(const char *name, const glm::vec2 &vec, const bool allow_invalid) const
 {
 	set_vec2(name, vec.x, vec.y, allow_invalid);
 	check_for_gl_errors();
 }
 
-void Shader::set_vec3(const std::string &name, const float val_1, const float val_2, const float val_3, const bool allow_invalid) const
+void Shader::set_vec3(const char *name, const float val_1, const float val_2, const float val_3, const bool allow_invalid) const
 {
 	glUniform3f(uniform_location(id_, name, allow_invalid), val_1, val_2, val_3);
 	check_for_gl_errors();
 }
 
-void Shader::set_vec3(const std::string &name, const glm::vec3 &vec, bool allow_invalid) const
+void Shader::set_vec3(const char *name, const glm::vec3 &vec, bool allow_invalid) const
 {
 	set_vec3(name, vec.x, vec.y, vec.z, allow_invalid);
 	check_for_gl_errors();
 }
 
-void Shader::set_vec4(const std::string &name, float val_1, float val_2, float val_3, float val_4, bool allow_invalid) const
+void Shader::set_vec4(const char *name, float val_1, float val_2, float val_3, float val_4, bool allow_invalid) const
 {
 	glUniform4f(uniform_location(id_, name, allow_invalid), val_1, val_2, val_3, val_4);
 	check_for_gl_errors();
 }
 
-void Shader::set_vec4(const std::string &name, const glm::vec4 &vec, bool allow_invalid) const
+void Shader::set_vec4(const char *name, const glm::vec4 &vec, bool allow_invalid) const
 {
 	set_vec4(name, vec.x, vec.y, vec.z, vec.w, allow_invalid);
 	check_for_gl_errors();
 }
 
-void Shader::set_mat2(const std::string &name, const glm::mat2 &mat, const bool allow_invalid) const
+void Shader::set_mat2(const char *name, const glm::mat2 &mat, const bool allow_invalid) const
 {
 	glUniformMatrix2fv(uniform_location(id_, name, allow_invalid), 1, GL_FALSE, &mat[0][0]);
 	check_for_gl_errors();
 }
 
-void Shader::set_mat3(const std::string &name, const glm::mat3 &mat, const bool allow_invalid) const
+void Shader::set_mat3(const char *name, const glm::mat3 &mat, const bool allow_invalid) const
 {
 	glUniformMatrix3fv(uniform_location(id_, name, allow_invalid), 1, GL_FALSE, &mat[0][0]);
 	check_for_gl_errors();
 }
 
-void Shader::set_mat4(const std::string &name, const glm::mat4 &mat, const bool allow_invalid) const
+void Shader::set_mat4(const char *name, const glm::mat4 &mat, const bool allow_invalid) const
 {
 	glUniformMatrix4fv(uniform_location(id_, name, allow_invalid), 1, GL_FALSE, &mat[0][0]);
 	check_for_gl_errors();
@@ -16,6 +16,7 @@ namespace util {
 		{
 		}
 
+		// linked from the ShaderCache when the sources were seen before
 		Shader(const char *vertex_path, const char *fragment_path, Optional<const char *> geometry_path);
 
 		unsigned int id() const
@@ -25,20 +26,23 @@ namespace util {
 
 		void use() const;
 
-		void set_bool(const std::string &name, bool value, bool allow_invalid) const;
-		void set_int(const std::string &name, int value, bool allow_invalid) const;
-		void set_float(const std::string &name, float value, bool allow_invalid) const;
-		void set_vec2(const std::string &name, float val_1, float val_2, bool allow_Invalid) const;
-		void set_vec2(const std::string &name, const glm::vec2 &vec, bool allow_invalid) const;
-		void set_vec3(const std::string &name, float val_1, float val_2, float val_3, bool allow_invalid) const;
-		void set_vec3(const std::string &name, const glm::vec3 &vec, bool allow_invalid) const;
-		void set_vec4(const std::string &name, float val_1, float val_2, float val_3, float val_4, bool allow_invalid) const;
-		void set_vec4(const std::string &name, const glm::vec4 &vec, bool allow_invalid) const;
-		void set_mat2(const std::string &name, const glm::mat2 &mat, bool allow_invalid) const;
-		void set_mat3(const std::string &name, const glm::mat3 &mat, bool allow_invalid) const;
-		void set_mat4(const std::string &name, const glm::mat4 &mat, bool allow_invalid) const;
+		void set_bool(const char *name, bool value, bool allow_invalid) const;
+		void set_int(const char *name, int value, bool allow_invalid) const;
+		void set_float(const char *name, float value, bool allow_invalid) const;
+		void set_vec2(const char *name, float val_1, float val_2, bool allow_Invalid) const;
+		void set_vec2(const char *name, const glm::vec2 &vec, bool allow_invalid) const;
+		void set_vec3(const char *name, float val_1, float val_2, float val_3, bool allow_invalid) const;
+		void set_vec3(const char *name, const glm::vec3 &vec, bool allow_invalid) const;
+		void set_vec4(const char *name, float val_1, float val_2, float val_3, float val_4, bool allow_invalid) const;
+		void set_vec4(const char *name, const glm::vec4 &vec, bool allow_invalid) const;
+		void set_mat2(const char *name, const glm::mat2 &mat, bool allow_invalid) const;
+		void set_mat3(const char *name, const glm::mat3 &mat, bool allow_invalid) const;
+		void set_mat4(const char *name, const glm::mat4 &mat, bool allow_invalid) const;
 
 	private:
+		// used when the program isn't in the ShaderCache; geometry_code may be null
+		void compile_and_link(const char *vertex_code, const char *geometry_code, const char *fragment_code);
+
 		unsigned int id_;
 	};
 
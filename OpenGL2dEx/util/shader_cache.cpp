@@ -0,0 +1,319 @@
+#include "shader_cache.h"
+
+#include "logging.h"
+#include "mapped_file.h"
+
+#include <glad/glad.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <initializer_list>
+
+#ifdef _WIN32
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#endif
+
+namespace util {
+
+namespace {
+	constexpr char kFileMagic[4] = { 'S', 'H', 'B', 'C' };
+	constexpr size_t kMaxPathLength{ 64 };
+
+	// FNV-1a
+	constexpr ShaderCache::Key kHashOffsetBasis{ 14695981039346656037ull };
+	constexpr ShaderCache::Key kHashPrime{ 1099511628211ull };
+
+	ShaderCache::Key hash_bytes(ShaderCache::Key hash, const unsigned char *data, const size_t size)
+	{
+		for (size_t i = 0; i < size; ++i)
+		{
+			hash = (hash ^ data[i]) * kHashPrime;
+		}
+		return hash;
+	}
+
+	ShaderCache::Key hash_string(const ShaderCache::Key hash, const char *str)
+	{
+		// the terminator is hashed too, so ("ab", "c") & ("a", "bc") differ
+		return hash_bytes(hash, reinterpret_cast<const unsigned char*>(str), std::strlen(str) + 1);
+	}
+
+	uint32_t read_u32(const unsigned char *data)
+	{
+		return static_cast<uint32_t>(data[0])
+			| (static_cast<uint32_t>(data[1]) << 8)
+			| (static_cast<uint32_t>(data[2]) << 16)
+			| (static_cast<uint32_t>(data[3]) << 24);
+	}
+
+	uint64_t read_u64(const unsigned char *data)
+	{
+		return static_cast<uint64_t>(read_u32(data)) | (static_cast<uint64_t>(read_u32(data + 4)) << 32);
+	}
+
+	void write_u16(unsigned char *data, const uint16_t value)
+	{
+		data[0] = static_cast<unsigned char>(value & 0xFF);
+		data[1] = static_cast<unsigned char>((value >> 8) & 0xFF);
+	}
+
+	void write_u32(unsigned char *data, const uint32_t value)
+	{
+		for (auto i = 0; i < 4; ++i)
+		{
+			data[i] = static_cast<unsigned char>((value >> (8 * i)) & 0xFF);
+		}
+	}
+
+	void write_u64(unsigned char *data, const uint64_t value)
+	{
+		write_u32(data, static_cast<uint32_t>(value & 0xFFFFFFFF));
+		write_u32(data + 4, static_cast<uint32_t>(value >> 32));
+	}
+
+	void cache_file_path(const ShaderCache::Key key, char (&path)[kMaxPathLength])
+	{
+		std::snprintf(path, kMaxPathLength, "%s/%016llx.bin", ShaderCache::kCacheDirectory, static_cast<unsigned long long>(key));
+	}
+
+	void make_cache_directory()
+	{
+		// fails harmlessly if it already exists; a failure to create it shows
+		// up as a failure to write the file
+#ifdef _WIN32
+		_mkdir(ShaderCache::kCacheDirectory);
+#else
+		mkdir(ShaderCache::kCacheDirectory, 0755);
+#endif
+	}
+} // namespace
+
+	constexpr const char *ShaderCache::kCacheDirectory;
+	constexpr size_t ShaderCache::kFileHeaderSize;
+	constexpr uint16_t ShaderCache::kFileVersion;
+
+	ShaderCache::Support                              ShaderCache::support_{ Support::kUnknown };
+	std::vector<int>                                  ShaderCache::supported_formats_{};
+	ShaderCache::Key                                  ShaderCache::driver_hash_{ 0 };
+	std::unordered_map<ShaderCache::Key, ShaderCache::Binary> ShaderCache::binaries_{};
+
+	unsigned int ShaderCache::cached_loads_{ 0 };
+	unsigned int ShaderCache::compiled_loads_{ 0 };
+	long long    ShaderCache::cached_load_microseconds_{ 0 };
+	long long    ShaderCache::compiled_load_microseconds_{ 0 };
+
+	ShaderCache::Key ShaderCache::key(const char * const *sources, const size_t count)
+	{
+		auto hash = kHashOffsetBasis;
+		for (size_t i = 0; i < count; ++i)
+		{
+			hash = hash_string(hash, sources[i] ? sources[i] : "");
+		}
+		return hash;
+	}
+
+	bool ShaderCache::load(const unsigned int program, const Key key)
+	{
+		if (!available())
+		{
+			return false;
+		}
+
+		auto found = binaries_.find(key);
+		if (found == binaries_.end())
+		{
+			Binary binary{};
+			if (!load_from_file(key, binary))
+			{
+				return false;
+			}
+			found = binaries_.emplace(key, std::move(binary)).first;
+		}
+
+		const auto &binary = found->second;
+		glProgramBinary(program, binary.format_, binary.data_.data(), static_cast<GLsizei>(binary.data_.size()));
+
+		// the driver may still reject a binary it made (e.g. after a driver
+		// update which kept the version string)
+		int success{};
+		glGetProgramiv(program, GL_LINK_STATUS, &success);
+		if (!success)
+		{
+			LOG("Cached shader binary rejected by driver; recompiling");
+			binaries_.erase(found);
+			return false;
+		}
+
+		return true;
+	}
+
+	void ShaderCache::prepare_for_link(const unsigned int program)
+	{
+		if (available())
+		{
+			glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+		}
+	}
+
+	void ShaderCache::store(const unsigned int program, const Key key)
+	{
+		if (!available())
+		{
+			return;
+		}
+
+		int length{};
+		glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+		if (length <= 0)
+		{
+			return;
+		}
+
+		Binary binary{};
+		binary.data_.resize(static_cast<size_t>(length));
+		GLenum format{};
+		GLsizei written{};
+		glGetProgramBinary(program, length, &written, &format, binary.data_.data());
+		binary.data_.resize(static_cast<size_t>(written));
+		binary.format_ = format;
+
+		write_file(key, binary);
+		binaries_[key] = std::move(binary);
+	}
+
+	void ShaderCache::record_load_time(const bool from_cache, const long long microseconds)
+	{
+		if (from_cache)
+		{
+			++cached_loads_;
+			cached_load_microseconds_ += microseconds;
+		}
+		else
+		{
+			++compiled_loads_;
+			compiled_load_microseconds_ += microseconds;
+		}
+	}
+
+	void ShaderCache::log_stats()
+	{
+		// a cold start (empty cache) compiles everything; a warm start should
+		// only compile what changed
+		LOG("Shaders: " << (cached_loads_ + compiled_loads_) << " programs in "
+			<< (cached_load_microseconds_ + compiled_load_microseconds_) << "us; "
+			<< cached_loads_ << " from cache (" << cached_load_microseconds_ << "us), "
+			<< compiled_loads_ << " compiled (" << compiled_load_microseconds_ << "us)"
+			<< (available() ? "" : "; program binaries unsupported"));
+	}
+
+	bool ShaderCache::available()
+	{
+		if (support_ == Support::kUnknown)
+		{
+			// core in 4.1; the context asks for 3.3, but drivers usually give more
+			int format_count{};
+			if (GLAD_GL_VERSION_4_1)
+			{
+				glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &format_count);
+			}
+
+			if (format_count > 0)
+			{
+				supported_formats_.resize(static_cast<size_t>(format_count));
+				glGetIntegerv(GL_PROGRAM_BINARY_FORMATS, supported_formats_.data());
+				driver_hash_ = driver_hash();
+				support_ = Support::kSupported;
+			}
+			else
+			{
+				support_ = Support::kUnsupported;
+			}
+		}
+
+		return support_ == Support::kSupported;
+	}
+
+	ShaderCache::Key ShaderCache::driver_hash()
+	{
+		auto hash = kHashOffsetBasis;
+		for (const auto name : { GL_VENDOR, GL_RENDERER, GL_VERSION })
+		{
+			const auto str = reinterpret_cast<const char*>(glGetString(name));
+			hash = hash_string(hash, str ? str : "");
+		}
+		return hash;
+	}
+
+	bool ShaderCache::load_from_file(const Key key, Binary &binary)
+	{
+		char path[kMaxPathLength];
+		cache_file_path(key, path);
+
+		MappedFile file{ path };
+		if (!file.is_open())
+		{
+			return false;
+		}
+
+		const auto data = file.data();
+		const auto size = file.size();
+		if (size < kFileHeaderSize
+			|| std::memcmp(data, kFileMagic, sizeof(kFileMagic)) != 0
+			|| static_cast<uint16_t>(data[4] | (data[5] << 8)) != kFileVersion)
+		{
+			LOG("Invalid shader cache file: " << path);
+			return false;
+		}
+
+		if (read_u64(data + 8) != key || read_u64(data + 16) != driver_hash_)
+		{
+			LOG("Shader cache file is for different sources or driver: " << path);
+			return false;
+		}
+
+		// a format the driver doesn't list would be an error rather than a
+		// failed link, so it's checked here
+		const auto format = read_u32(data + 24);
+		const auto length = read_u32(data + 28);
+		if (size - kFileHeaderSize < length
+			|| std::find(supported_formats_.begin(), supported_formats_.end(), static_cast<int>(format)) == supported_formats_.end())
+		{
+			LOG("Unusable shader cache file: " << path);
+			return false;
+		}
+
+		binary.format_ = format;
+		binary.data_.assign(data + kFileHeaderSize, data + kFileHeaderSize + length);
+		return true;
+	}
+
+	void ShaderCache::write_file(const Key key, const Binary &binary)
+	{
+		make_cache_directory();
+
+		char path[kMaxPathLength];
+		cache_file_path(key, path);
+
+		unsigned char header[kFileHeaderSize]{};
+		std::memcpy(header, kFileMagic, sizeof(kFileMagic));
+		write_u16(header + 4, kFileVersion);
+		write_u16(header + 6, 0);
+		write_u64(header + 8, key);
+		write_u64(header + 16, driver_hash_);
+		write_u32(header + 24, binary.format_);
+		write_u32(header + 28, static_cast<uint32_t>(binary.data_.size()));
+
+		std::ofstream file{ path, std::ios::binary | std::ios::trunc };
+		file.write(reinterpret_cast<const char*>(header), sizeof(header));
+		file.write(reinterpret_cast<const char*>(binary.data_.data()), static_cast<std::streamsize>(binary.data_.size()));
+		if (!file)
+		{
+			LOG("Failed to write shader cache file: " << path);
+		}
+	}
+
+} // namespace util
\ No newline at end of file
@@ -0,0 +1,89 @@
+#ifndef SHADER_CACHE_H
+#define SHADER_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace util {
+
+// Caches linked shader programs as driver binaries (glGetProgramBinary), so
+// later loads of the same sources skip compiling & linking.  Binaries are
+// kept in memory for the rest of the launch (the same program is loaded by
+// several elements) & written to kCacheDirectory for the next one.  A cached
+// binary is only used if its sources & the driver (vendor, renderer &
+// version strings) match; otherwise, or if the driver rejects it, the
+// program is compiled as usual & the cache entry replaced.
+//
+// cache file (<kCacheDirectory>/<source hash>.bin), all fields little-endian:
+//   offset  size  field
+//   0       4     magic "SHBC"
+//   4       2     version (kFileVersion)
+//   6       2     reserved
+//   8       8     source hash
+//   16      8     driver hash
+//   24      4     binary format
+//   28      4     binary length
+//   32      n     binary
+class ShaderCache {
+public:
+	using Key = uint64_t;
+
+	static constexpr const char *kCacheDirectory = "shader_cache";
+	static constexpr size_t      kFileHeaderSize{ 32 };
+	static constexpr uint16_t    kFileVersion{ 1 };
+
+	// hash of the program's sources, in order; null sources are skipped
+	static Key key(const char * const *sources, size_t count);
+
+	// true if program was linked from a cached binary
+	static bool load(unsigned int program, Key key);
+
+	// call before linking a program that will be stored
+	static void prepare_for_link(unsigned int program);
+
+	// saves the binary of a successfully linked program
+	static void store(unsigned int program, Key key);
+
+	// for reporting startup cost
+	static void record_load_time(bool from_cache, long long microseconds);
+	static void log_stats();
+
+private:
+	// singleton
+	ShaderCache()
+	{
+	}
+
+	struct Binary {
+		uint32_t                   format_;
+		std::vector<unsigned char> data_;
+	}; // struct Binary
+
+	// checked on first use, once there's a context
+	static bool available();
+	static Key  driver_hash();
+
+	static bool load_from_file(Key key, Binary &binary);
+	static void write_file(Key key, const Binary &binary);
+
+	enum class Support {
+		kUnknown,
+		kSupported,
+		kUnsupported,
+	}; // enum class Support
+	static Support                     support_;
+	static std::vector<int>            supported_formats_;
+	static Key                         driver_hash_;
+	static std::unordered_map<Key, Binary> binaries_;
+
+	static unsigned int cached_loads_;
+	static unsigned int compiled_loads_;
+	static long long    cached_load_microseconds_;
+	static long long    compiled_load_microseconds_;
+}; // class ShaderCache
+
+} // namespace util
+
+#endif // SHADER_CACHE_H
\ No newline at end of file
@@ -1,5 +1,4 @@
 #include "sprite_renderer.h"
-#include "texture_2d.h"
 
 #include "gl_debug.h"
 
@@ -16,7 +15,7 @@ SpriteRenderer::~SpriteRenderer()
 	glDeleteVertexArrays(1, &quad_vao_);
 }
 
-void SpriteRenderer::draw(const Texture2D &texture, glm::vec2 position,
+void SpriteRenderer::draw(const ResourceManager::Texture2DId texture_id, glm::vec2 position,
 						  glm::vec2 size, float rotate, glm::vec3 color)
 {
 	glm::mat4 model = glm::mat4(1.0f);
@@ -33,7 +32,7 @@ void SpriteRenderer::draw(const Texture2D &texture, glm::vec2 position,
 	shader_.set_vec3("u_sprite_color_", color, false);
 
 	glActiveTexture(GL_TEXTURE0);
-	texture.bind();
+	ResourceManager::get_texture(texture_id).bind();
 
 	glBindVertexArray(quad_vao_);
 	glDrawArrays(GL_TRIANGLES, 0, 6);
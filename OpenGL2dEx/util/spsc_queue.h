@@ -0,0 +1,111 @@
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+
+namespace util {
+
+// Bounded, lock-free queue for handing values from exactly one producer
+// thread to exactly one consumer thread.  push() & pop() never block or
+// allocate; push() fails when the queue is full
+template <typename Value, size_t kCapacity>
+class SpscQueue {
+public:
+	static_assert(kCapacity > 0 && (kCapacity & (kCapacity - 1)) == 0, "SpscQueue capacity must be a power of 2");
+
+	SpscQueue()
+		: values_{}
+		, head_{ 0 }
+		, padding_{}
+		, tail_{ 0 }
+	{
+	}
+
+	SpscQueue(const SpscQueue&) = delete;
+	SpscQueue &operator=(const SpscQueue&) = delete;
+
+	// producer only
+	bool push(const Value &value)
+	{
+		const auto tail = tail_.load(std::memory_order_relaxed);
+		if (tail - head_.load(std::memory_order_acquire) == kCapacity)
+		{
+			return false;
+		}
+
+		values_[tail & kMask] = value;
+		tail_.store(tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	// consumer only
+	bool pop(Value &value)
+	{
+		const auto head = head_.load(std::memory_order_relaxed);
+		if (head == tail_.load(std::memory_order_acquire))
+		{
+			return false;
+		}
+
+		value = values_[head & kMask];
+		head_.store(head + 1, std::memory_order_release);
+		return true;
+	}
+
+	// bulk versions, for streams of samples; move as many values as fit/are
+	// queued (up to count) & return how many that was.  Producer only
+	size_t push(const Value *values, const size_t count)
+	{
+		const auto tail = tail_.load(std::memory_order_relaxed);
+		const auto pushed = std::min(count, kCapacity - (tail - head_.load(std::memory_order_acquire)));
+		for (size_t index = 0; index < pushed; ++index)
+		{
+			values_[(tail + index) & kMask] = values[index];
+		}
+		tail_.store(tail + pushed, std::memory_order_release);
+		return pushed;
+	}
+
+	// consumer only
+	size_t pop(Value *values, const size_t count)
+	{
+		const auto head = head_.load(std::memory_order_relaxed);
+		const auto popped = std::min(count, tail_.load(std::memory_order_acquire) - head);
+		for (size_t index = 0; index < popped; ++index)
+		{
+			values[index] = values_[(head + index) & kMask];
+		}
+		head_.store(head + popped, std::memory_order_release);
+		return popped;
+	}
+
+	// values waiting to be popped: at least this many on the consumer, at most
+	// this many on the producer
+	size_t size() const
+	{
+		return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+	}
+
+	// empties the queue; only while neither thread is using it
+	void clear()
+	{
+		head_.store(tail_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+	}
+
+private:
+	static constexpr size_t kMask{ kCapacity - 1 };
+	static constexpr size_t kCacheLineSize{ 64 };
+
+	Value               values_[kCapacity];
+	std::atomic<size_t> head_; // next to pop; written by the consumer
+	// keeps head_ & tail_ on separate cache lines, so the two threads don't
+	// contend for one (alignas would need an aligned operator new for heap use)
+	char                padding_[kCacheLineSize - sizeof(std::atomic<size_t>)];
+	std::atomic<size_t> tail_; // next to push; written by the producer
+}; // class SpscQueue
+
+} // namespace util
+
+#endif // SPSC_QUEUE_H
\ No newline at end of file
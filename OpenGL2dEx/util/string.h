@@ -3,6 +3,9 @@
 
 #include "array_helpers.h"
 
+#include <cstring>
+#include <type_traits>
+
 namespace util {
 
 template<typename STORAGE_TYPE, STORAGE_TYPE terminating_character, typename INDEX_TYPE>
@@ -22,8 +25,62 @@ INDEX_TYPE generic_strlen(const STORAGE_TYPE *str)
 	return len;
 }
 
+namespace impl {
+	// ordinary C strings go through the C library, which scans a word or
+	// vector at a time rather than a character at a time
+	template<typename STORAGE_TYPE, STORAGE_TYPE terminating_character>
+	struct is_c_string
+	{
+		static constexpr bool value = std::is_same<STORAGE_TYPE, char>::value && terminating_character == STORAGE_TYPE{};
+	};
+
+	template<typename STORAGE_TYPE, STORAGE_TYPE terminating_character, typename INDEX_TYPE,
+			 std::enable_if_t<is_c_string<STORAGE_TYPE, terminating_character>::value, bool> = true>
+	INDEX_TYPE fast_strlen(const STORAGE_TYPE *str)
+	{
+		return static_cast<INDEX_TYPE>(std::strlen(str));
+	}
+
+	template<typename STORAGE_TYPE, STORAGE_TYPE terminating_character, typename INDEX_TYPE,
+			 std::enable_if_t<!is_c_string<STORAGE_TYPE, terminating_character>::value, bool> = true>
+	INDEX_TYPE fast_strlen(const STORAGE_TYPE *str)
+	{
+		return generic_strlen<STORAGE_TYPE, terminating_character, INDEX_TYPE>(str);
+	}
+
+	// the length of str, but never reading more than max_length characters;
+	// max_length if there's no terminator in them
+	template<typename STORAGE_TYPE, STORAGE_TYPE terminating_character, typename INDEX_TYPE,
+			 std::enable_if_t<is_c_string<STORAGE_TYPE, terminating_character>::value, bool> = true>
+	INDEX_TYPE fast_strnlen(const STORAGE_TYPE *str, const INDEX_TYPE max_length)
+	{
+		// memchr stops at the first match, so it doesn't read past str's terminator
+		const auto terminator = static_cast<const STORAGE_TYPE*>(std::memchr(str, terminating_character, max_length));
+		return terminator ? static_cast<INDEX_TYPE>(terminator - str) : max_length;
+	}
+
+	template<typename STORAGE_TYPE, STORAGE_TYPE terminating_character, typename INDEX_TYPE,
+			 std::enable_if_t<!is_c_string<STORAGE_TYPE, terminating_character>::value, bool> = true>
+	INDEX_TYPE fast_strnlen(const STORAGE_TYPE *str, const INDEX_TYPE max_length)
+	{
+		auto len = INDEX_TYPE{ 0 };
+		while (len < max_length && str[len] != terminating_character)
+		{
+			++len;
+		}
+		return len;
+	}
+} // namespace impl
+
+// Fixed capacity string which tracks its length, so copies & comparisons are
+// bulk memcpy/memcmp calls sized by it.  Strings built from literals get their
+// length at compile time.  The hash is computed on first use & kept until the
+// string changes; it's copied along w/ the string, & two strings whose hashes
+// are known & differ are unequal w/o comparing them
 template <typename STORAGE_TYPE, STORAGE_TYPE terminating_character, typename INDEX_TYPE, INDEX_TYPE N>
 class string_base {
+	static_assert(std::is_trivially_copyable<STORAGE_TYPE>::value, "string storage must be trivially copyable");
+
 public:
 	template <size_t LENGTH>
 	using string_type = string_base<STORAGE_TYPE, terminating_character, INDEX_TYPE, LENGTH>;
@@ -35,37 +92,89 @@ public:
 	static constexpr auto kTerminator = terminating_character;
 	static constexpr auto kStorageLength = kMaxLength + 1;
 
+	using HashType = size_t;
+
+	// string_view-like aliases
+	using value_type = StorageType;
+	using size_type = Index;
+	using const_iterator = const StorageType*;
+
 private:
-	auto strlen_local(const StorageType *str)
+	static Index strlen_local(const StorageType *str)
 	{
-		return generic_strlen<StorageType, kTerminator, Index>(str);
+		return impl::fast_strlen<StorageType, kTerminator, Index>(str);
+	}
+
+	static Index strnlen_local(const StorageType *str, const Index max_length)
+	{
+		return impl::fast_strnlen<StorageType, kTerminator, Index>(str, max_length);
+	}
+
+	template <size_t ARRAY_LENGTH>
+	static constexpr Index literal_length(const StorageType(&str)[ARRAY_LENGTH])
+	{
+		// a literal's terminator is its last element, but stop at the first
+		// in case this is a partly filled buffer
+		auto len = Index{ 0 };
+		while (len < ARRAY_LENGTH - 1 && str[len] != kTerminator)
+		{
+			++len;
+		}
+		return len;
 	}
 
 public:
-	string_base()
+	constexpr string_base()
 		: length_{ 0 }
 		, string_{}
+		, hash_{ 0 }
+		, hash_valid_{ false }
+	{
+	}
+
+	// string literals & character arrays: the length is found at compile
+	// time when the array is a constant
+	template <size_t ARRAY_LENGTH>
+	constexpr string_base(const StorageType(&str)[ARRAY_LENGTH])
+		: length_{ literal_length(str) }
+		, string_{}
+		, hash_{ 0 }
+		, hash_valid_{ false }
 	{
+		static_assert(ARRAY_LENGTH - 1 <= kMaxLength, "Array too long for string; pass a pointer to a partly filled buffer");
+
+		for (Index i = 0; i < length_; ++i)
+		{
+			string_[i] = str[i];
+		}
+		string_[length_] = kTerminator;
 	}
 
-	string_base(const StorageType *str)
+	// a template, so string literals prefer the array constructor above
+	template <typename POINTER,
+		std::enable_if_t<std::is_convertible<POINTER, const StorageType *>::value && !std::is_array<POINTER>::value, bool> = true>
+	string_base(const POINTER &str)
 		: length_{}
 		, string_{}
+		, hash_{ 0 }
+		, hash_valid_{ false }
 	{
-		set_string(str);
+		set_string(str, strlen_local(str));
 	}
 
 	template <Index OTHER_N>
 	string_base(const string_type<OTHER_N> &other)
 		: length_{}
 		, string_{}
+		, hash_{ 0 }
+		, hash_valid_{ false }
 	{
 		*this = other;
 	}
 
 	string_type<kMaxLength>& operator=(const StorageType *str)
 	{
-		set_string(str);
+		set_string(str, strlen_local(str));
 
 		return *this;
 	}
@@ -73,21 +182,18 @@ public:
 	template <Index OTHER_N>
 	string_type<kMaxLength>& operator=(const string_type<OTHER_N> &other)
 	{
-		set_string(other.c_str());
+		set_string(other.c_str(), other.length());
+		// same characters, same hash
+		hash_ = other.hash_valid() ? other.hash() : HashType{ 0 };
+		hash_valid_ = other.hash_valid();
 
 		return *this;
 	}
 
 	string_type<kMaxLength> operator+(const StorageType *str)
 	{
-		const auto other_length = strlen_local(str);
-
-		ASSERT(other_length + length_ <= kMaxLength, "Combined string would be too large");
-
 		string_base<StorageType, kTerminator, Index, kMaxLength> ret{ *this };
-		// include terminating character
-		copy_ptr_to_ptr(str, &ret.string_[ret.length_], other_length + 1);
-		ret.length_ += other_length;
+		ret.append(str, strlen_local(str));
 
 		return ret;
 	}
@@ -96,18 +202,13 @@ public:
 	string_type<kMaxLength + OTHER_N> operator+(const string_type<OTHER_N>& other)
 	{
 		string_type<kMaxLength + OTHER_N> ret{ *this };
-		return ret + other.c_str();
+		ret += other;
+		return ret;
 	}
 
 	string_type<kMaxLength>& operator+=(const StorageType *str)
 	{
-		const auto other_length = strlen_local(str);
-
-		ASSERT(length_ + other_length <= kMaxLength, "Combined string too long");
-
-		// include terminating character
-		copy_ptr_to_ptr(str, string_ + length_, other_length + 1);
-		length_ += other_length;
+		append(str, strlen_local(str));
 
 		return *this;
 	}
@@ -115,25 +216,20 @@ public:
 	template<Index OTHER_N>
 	string_type<kMaxLength>& operator+=(const string_type<OTHER_N> &other)
 	{
-		ASSERT(length_ + other.length() <= kMaxLength, "Combined string too long");
-
-		// include terminating character
-		copy_ptr_to_ptr(other.c_str(), string_ + length_, other.length() + 1);
-		length_ += other.length();
+		append(other.c_str(), other.length());
 
 		return *this;
 	}
 
 	bool operator==(const StorageType *str) const
 	{
-		// expects that str is of size length_ + 1 or greater
-		for (Index i = 0; i < length_ + 1; ++i)
-		{
-			if (string_[i] != str[i])
-				return false;
-		}
+		// str's length is only looked for up to one past this string's, so a
+		// longer str isn't scanned to its end & a shorter one isn't read past
+		// its terminator
+		if (strnlen_local(str, length_ + 1) != length_)
+			return false;
 
-		return true;
+		return std::memcmp(string_, str, length_ * sizeof(StorageType)) == 0;
 	}
 
 	template<Index OTHER_N>
@@ -142,7 +238,10 @@ public:
 		if (str.length() != length_)
 			return false;
 
-		return (*this == str.c_str());
+		if (hash_valid_ && str.hash_valid() && hash_ != str.hash())
+			return false;
+
+		return std::memcmp(string_, str.c_str(), length_ * sizeof(StorageType)) == 0;
 	}
 
 	bool operator!=(const StorageType *str) const
@@ -163,6 +262,7 @@ public:
 		string_[length_] = c;
 		++length_;
 		string_[length_] = kTerminator;
+		hash_valid_ = false;
 	}
 
 	void append(const StorageType &c)
@@ -196,12 +296,14 @@ public:
 
 		string_[length_ - 1] = kTerminator;
 		--length_;
+		hash_valid_ = false;
 	}
 
 	void clear()
 	{
 		length_ = 0;
 		string_[0] = kTerminator;
+		hash_valid_ = false;
 	}
 
 	const StorageType *c_str() const
@@ -209,42 +311,98 @@ public:
 		return static_cast<const StorageType *>(string_);
 	}
 
+	const StorageType *data() const
+	{
+		return c_str();
+	}
+
+	StorageType operator[](const Index index) const
+	{
+		ASSERT(index <= length_, "Index out of bounds");
+
+		return string_[index];
+	}
+
+	const_iterator begin() const
+	{
+		return string_;
+	}
+
+	const_iterator end() const
+	{
+		return string_ + length_;
+	}
+
 	static constexpr auto max_size()
 	{
 		return kMaxLength;
 	}
 
-	auto size() const
+	constexpr auto size() const
 	{
 		return length_;
 	}
 
-	auto length() const
+	constexpr auto length() const
 	{
 		return length_;
 	}
 
-	bool empty() const
+	constexpr bool empty() const
 	{
 		return (length_ == 0);
 	}
 
-private:
-	void set_string(const StorageType *str)
+	// FNV-1a
+	HashType hash() const
 	{
-		length_ = strlen_local(str);
-		if (length_ > 0)
-		{
-			copy_ptr_to_arr(str, string_, length_ + 1);
-		}
-		else
+		if (!hash_valid_)
 		{
-			string_[0] = kTerminator;
+			auto hash = kHashOffsetBasis;
+			const auto bytes = reinterpret_cast<const unsigned char*>(string_);
+			for (size_t i = 0; i < length_ * sizeof(StorageType); ++i)
+			{
+				hash = (hash ^ bytes[i]) * kHashPrime;
+			}
+			hash_ = hash;
+			hash_valid_ = true;
 		}
+		return hash_;
+	}
+
+	bool hash_valid() const
+	{
+		return hash_valid_;
+	}
+
+private:
+	static constexpr auto kHashOffsetBasis = static_cast<HashType>(14695981039346656037ull);
+	static constexpr auto kHashPrime = static_cast<HashType>(1099511628211ull);
+
+	void set_string(const StorageType *str, const Index length)
+	{
+		ASSERT(length <= kMaxLength, "String too long");
+
+		// include terminating character
+		copy_ptr_to_ptr(str, string_, length + 1);
+		length_ = length;
+		hash_valid_ = false;
+	}
+
+	void append(const StorageType *str, const Index length)
+	{
+		ASSERT(length_ + length <= kMaxLength, "Combined string too long");
+
+		// include terminating character
+		copy_ptr_to_ptr(str, string_ + length_, length + 1);
+		length_ += length;
+		hash_valid_ = false;
 	}
 
 	Index length_;
 	StorageType string_[kStorageLength];
+	mutable HashType hash_;
+	mutable bool     hash_valid_;
 }; // class string
 
 template<size_t N>
@@ -112,7 +112,7 @@ void TextRenderer::update_size(Dimension width, Dimension height) const
 	shader_->set_mat4("u_projection_", make_ortho(width, height), false);
 }
 
-void TextRenderer::render_text(const std::string &text, 
+void TextRenderer::render_text(const char *text, 
 							   const float x, 
 							   const float y, 
 							   const float scale, 
@@ -133,7 +133,7 @@ void TextRenderer::render_text(const std::string &text,
 	glBindVertexArray(vao_);
 
 	auto next_x = x;
-	for (auto c = text.cbegin(); c != text.cend(); ++c)
+	for (auto c = text; *c != '\0'; ++c)
 	{
 		// TODO(sasiala): should we allow unknown characters and display something in
 		// particular?  Perhaps a box?
@@ -54,7 +54,7 @@ public:
 
 	void load(const char *font_path, FontSize font_size);
 	void update_size(Dimension width, Dimension height) const;
-	void render_text(const std::string &text, 
+	void render_text(const char *text, 
 					 float x, 
 					 float y, 
 					 float scale, 
@@ -9,7 +9,7 @@
 namespace util {
 
 template <size_t NUM_OPTIONS>
-class TextToggle : public Element
+class TextToggle final : public Element
 {
 public:
 	static constexpr auto kNumOptions = NUM_OPTIONS;
@@ -99,9 +99,12 @@ public:
 		ASSERT(index < kNumOptions, "Given index out of bounds");
 
 		selected_option_ = index;
+		mark_dirty();
 	}
 
 private:
+	friend class Element; // for the *_final calls
+
 	// Element
 	void initialize_impl(const glm::mat4 &projection) override
 	{
@@ -135,25 +138,30 @@ private:
 		auto label_render = [](Label &label, const Optional<SpriteRenderer*> &parent_sprite_renderer) { label.render(parent_sprite_renderer); };
 		apply(labels_, label_render, parent_sprite_renderer);
 	}
-	void set_key_impl(KeyId key_id, bool val) override
+	void process_input_impl(const InputState &input, Time dt) override
 	{
 		if (!is_active())
 		{
 			return;
 		}
 
-		auto function = [](Label &label, KeyId key_id, bool val) { label.set_key(key_id, val); };
-		apply(labels_, function, key_id, val);
+		auto label_process_input = [](Label &label, const InputState &input, float dt) { label.process_input(input, dt); };
+		apply(labels_, label_process_input, input, dt);
 	}
-	void process_input_impl(Time dt) override
+	bool is_dirty_impl() const override
 	{
-		if (!is_active())
+		for (const auto &label : labels_)
 		{
-			return;
+			if (label.is_dirty())
+			{
+				return true;
+			}
 		}
-
-		auto label_process_input = [](Label &label, float dt) { label.process_input(dt); };
-		apply(labels_, label_process_input, dt);
+		return false;
+	}
+	void clear_dirty_impl() override
+	{
+		apply(labels_, [](Label &label) { label.clear_dirty(); });
 	}
 
 	Label labels_[kNumOptions];
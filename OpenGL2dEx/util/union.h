@@ -2,9 +2,12 @@
 #define UNION_H
 
 #include "array_helpers.h"
+#include "logging.h"
 #include "template_helpers.h"
 
+#include <new>
 #include <type_traits>
+#include <utility>
 
 namespace util {
 
@@ -59,259 +62,324 @@ namespace util {
 
 		template<typename CHECK_TYPE, typename ...Types>
 		static constexpr bool enable_set_v = enable_get<CHECK_TYPE, Types...>::value;
+
+		// index of the first of Types which is CHECK_TYPE; sizeof...(Types) if there is none
+		template<typename CHECK_TYPE, typename ...Types>
+		struct index_of;
+
+		template<typename CHECK_TYPE>
+		struct index_of<CHECK_TYPE>
+		{
+			static constexpr size_t value = 0;
+		};
+
+		template<typename CHECK_TYPE, typename T0, typename ...Types>
+		struct index_of<CHECK_TYPE, T0, Types...>
+		{
+			static constexpr size_t value = std::is_same<CHECK_TYPE, T0>::value
+											? 0
+											: 1 + index_of<CHECK_TYPE, Types...>::value;
+		};
+
+		// mirror enable_get/enable_set: an exact match wins, otherwise the pointed-to constness is ignored
+		template<typename CHECK_TYPE, typename ...Types>
+		struct get_index
+		{
+			static constexpr size_t kExactIndex = index_of<std::remove_const_t<CHECK_TYPE>, Types...>::value;
+			static constexpr size_t value = (kExactIndex < sizeof...(Types))
+											? kExactIndex
+											: index_of<strip_const_from_pointed_to_type_t<std::remove_const_t<CHECK_TYPE>>, Types...>::value;
+		};
+
+		template<typename CHECK_TYPE, typename ...Types>
+		struct set_index
+		{
+			static constexpr size_t kExactIndex = index_of<std::remove_const_t<CHECK_TYPE>, Types...>::value;
+			static constexpr size_t value = (kExactIndex < sizeof...(Types))
+											? kExactIndex
+											: index_of<std::remove_const_t<CHECK_TYPE>, strip_const_from_pointed_to_type_t<Types>...>::value;
+		};
+
+		template<size_t INDEX, typename ...Types>
+		struct type_at;
+
+		template<typename T0, typename ...Types>
+		struct type_at<0, T0, Types...>
+		{
+			using type = T0;
+		};
+
+		template<size_t INDEX, typename T0, typename ...Types>
+		struct type_at<INDEX, T0, Types...>
+		{
+			using type = typename type_at<INDEX - 1, Types...>::type;
+		};
+
+		template<size_t INDEX, typename ...Types>
+		using type_at_t = typename type_at<INDEX, Types...>::type;
 	} // namespace impl
 
+	// Holds at most one of Types, tagged by its index in Types.  Destroying,
+	// copying, moving & visiting index into constexpr tables of functions
+	// (one per type), so each costs a single indirect call & no heap/vtables.
 	template<typename ...Types>
 	class UnionBase {
+		static_assert(sizeof...(Types) > 0, "Union must be able to hold at least one type");
+
 	protected:
 		static constexpr size_t kDataSize = impl::max_size<Types...>::value;
 		using StorageType = unsigned char;
 		static constexpr size_t kArraySize = kDataSize / sizeof(StorageType);
 		using StorageArray = StorageType[kArraySize];
 
-	private:
-		struct Destroyer {
-			virtual void destroy(StorageArray data) = 0;
-		};
-
-		template<typename T>
-		class DestroyerImpl : public Destroyer {
-		public:
-			void destroy(StorageArray data) override
-			{
-				destroy_impl(reinterpret_cast<T&>(*data));
-			}
+	public:
+		using Index = size_t;
+		static constexpr Index kNoValue = sizeof...(Types);
 
-		private:
-			template<typename T2, std::enable_if_t<std::is_destructible<T2>::value, bool> = true>
-			void destroy_impl(T2 &obj)
-			{
-				obj.~T2();
-			}
+	private:
+		template<typename T, std::enable_if_t<std::is_destructible<T>::value, bool> = true>
+		static void destroy_obj(StorageType *data)
+		{
+			reinterpret_cast<T*>(data)->~T();
+		}
 
-			template<typename T2, std::enable_if_t<not<std::is_destructible<T2>>::value, bool> = true>
-			void destroy_impl(T2 &/*obj*/)
-			{
-			}
-		};
+		template<typename T, std::enable_if_t<not<std::is_destructible<T>>::value, bool> = true>
+		static void destroy_obj(StorageType * /*data*/)
+		{
+		}
 
 		template<typename T>
-		static Destroyer *destroyer_dispatch()
+		static void copy_obj(const StorageType *origin, StorageType *destination)
 		{
-			static DestroyerImpl<T> destroyer{};
-			return &destroyer;
+			new(destination) T(*reinterpret_cast<const T*>(origin));
 		}
 
-		struct Copier {
-			virtual void copy(const StorageArray origin, StorageArray destination) = 0;
-		};
-
 		template<typename T>
-		class CopierImpl : public Copier {
-		public:
-			void copy(const StorageArray origin, StorageArray destination) override
-			{
-				copy_obj(reinterpret_cast<const T&>(*origin), destination);
-			}
+		static void move_obj(StorageType *origin, StorageType *destination)
+		{
+			new(destination) T(std::move(*reinterpret_cast<T*>(origin)));
+		}
 
-			void copy_obj(const T &origin, StorageArray destination)
-			{
-				new(destination) T(origin);
-			}
-		};
+		template<typename Result, typename Visitor, typename T>
+		static Result visit_obj(Visitor &visitor, StorageType *data)
+		{
+			return visitor(*reinterpret_cast<T*>(data));
+		}
 
-		template<typename T>
-		static Copier *copier_dispatch()
+		template<typename Result, typename Visitor, typename T>
+		static Result visit_const_obj(Visitor &visitor, const StorageType *data)
 		{
-			static CopierImpl<T> copier{};
-			return &copier;
+			return visitor(*reinterpret_cast<const T*>(data));
 		}
 
+		using DestroyFunction = void(*)(StorageType*);
+		using CopyFunction = void(*)(const StorageType*, StorageType*);
+		using MoveFunction = void(*)(StorageType*, StorageType*);
+
+		static constexpr DestroyFunction kDestroyers[] = { &destroy_obj<Types>... };
+		static constexpr CopyFunction kCopiers[] = { &copy_obj<Types>... };
+		static constexpr MoveFunction kMovers[] = { &move_obj<Types>... };
+
+		using FirstType = impl::type_at_t<0, Types...>;
+
 	public:
 		template<typename = std::enable_if_t<impl::are_types_valid_for_union<Types...>()>>
 		UnionBase()
 			: data_{}
-			, destroyer_{ nullptr }
-			, copier_{ nullptr }
-			, initialized_{ false }
+			, index_{ kNoValue }
 		{
 		}
 
 		template<typename T,
 			typename = std::enable_if_t<impl::are_types_valid_for_union<Types...>()>,
-			typename = std::enable_if_t<impl::enable_set_v<T, Types...>>>
-			UnionBase(const T &data)
+			typename = std::enable_if_t<impl::enable_set_v<std::decay_t<T>, Types...>>>
+			UnionBase(T &&data)
 			: data_{}
-			, destroyer_{ nullptr }
-			, copier_{ nullptr }
-			, initialized_{ false }
+			, index_{ kNoValue }
 		{
-			set(data);
+			set(std::forward<T>(data));
 		}
 
 		UnionBase(const UnionBase<Types...> &other)
 			: data_{}
-			, destroyer_{ other.destroyer_ }
-			, copier_{ other.copier_ }
-			, initialized_{ other.initialized_ }
+			, index_{ kNoValue }
+		{
+			copy_from(other);
+		}
+
+		UnionBase(UnionBase<Types...> &&other)
+			: data_{}
+			, index_{ kNoValue }
 		{
-			if (initialized_)
+			move_from(other);
+		}
+
+		UnionBase &operator=(const UnionBase<Types...> &other)
+		{
+			if (this != &other)
 			{
-				copier_->copy(other.data_, data_);
+				reset();
+				copy_from(other);
 			}
+			return *this;
 		}
 
-		virtual ~UnionBase()
+		UnionBase &operator=(UnionBase<Types...> &&other)
 		{
-			if (initialized_)
+			if (this != &other)
 			{
-				destroyer_->destroy(data_);
+				reset();
+				move_from(other);
 			}
+			return *this;
+		}
+
+		~UnionBase()
+		{
+			reset();
 		}
 
 		template <typename T,
 			typename = std::enable_if_t<impl::enable_get_v<T, Types...>>>
 			T& get()
 		{
-			ASSERT(initialized_, "Union currently contains no value");
+			ASSERT(index_ == (impl::get_index<T, Types...>::value), "Union does not contain the requested type");
 			return reinterpret_cast<T&>(*data_);
 		}
 
 		template <typename T,
-			typename = std::enable_if_t<impl::enable_set_v<T, Types...>>>
-			void set(const T &data)
+			typename = std::enable_if_t<impl::enable_set_v<std::decay_t<T>, Types...>>>
+			void set(T &&data)
+		{
+			static constexpr Index kIndex = impl::set_index<std::decay_t<T>, Types...>::value;
+			using StoredType = impl::type_at_t<kIndex, Types...>;
+
+			// destroy & copy/move-construct using placement new
+			reset();
+			new(data_) StoredType(std::forward<T>(data));
+			index_ = kIndex;
+		}
+
+		void reset()
 		{
-			// destroy & copy-construct using placement new
-			if (initialized_)
+			if (data_valid())
 			{
-				ASSERT(destroyer_, "No defined destroyer");
-				destroyer_->destroy(data_);
+				kDestroyers[index_](data_);
+				index_ = kNoValue;
 			}
+		}
+
+		Index index() const
+		{
+			return index_;
+		}
+
+		// calls visitor with the held object as its actual type; visitor must
+		// accept each of Types & return the same type for all of them
+		template<typename Visitor>
+		decltype(auto) visit(Visitor &&visitor)
+		{
+			using Result = decltype(visitor(std::declval<FirstType&>()));
+			using VisitFunction = Result(*)(Visitor&, StorageType*);
+			static constexpr VisitFunction kVisitors[] = { &visit_obj<Result, Visitor, Types>... };
+
+			ASSERT(data_valid(), "Union currently contains no value");
+			return kVisitors[index_](visitor, data_);
+		}
 
-			copier_ = copier_dispatch<T>();
-			CopierImpl<T> copier{};
-			copier.copy_obj(data, data_);
+		template<typename Visitor>
+		decltype(auto) visit(Visitor &&visitor) const
+		{
+			using Result = decltype(visitor(std::declval<const FirstType&>()));
+			using VisitFunction = Result(*)(Visitor&, const StorageType*);
+			static constexpr VisitFunction kVisitors[] = { &visit_const_obj<Result, Visitor, Types>... };
 
-			destroyer_ = destroyer_dispatch<T>();
-			initialized_ = true;
+			ASSERT(data_valid(), "Union currently contains no value");
+			return kVisitors[index_](visitor, data_);
 		}
+
 	protected:
 		bool data_valid() const
 		{
-			return initialized_;
+			return index_ != kNoValue;
 		}
 
 		StorageArray& data()
 		{
 			return data_;
 		}
-	private:
-		StorageArray alignas(Types...) data_;
-		Destroyer    *destroyer_;
-		Copier       *copier_;
-		bool          initialized_;
-	};
 
-	template<typename ...Types>
-	using Union = UnionBase<Types...>;
-
-	template<typename PTR_TYPE, typename ...Types>
-	class UnionWithDataPtr : public UnionBase<Types...>
-	{
-	public:
-		using BaseType = UnionBase<Types...>;
-		using PointerType = PTR_TYPE;
-		using BaseType::StorageType;
-		using BaseType::StorageArray;
+		const StorageArray& data() const
+		{
+			return data_;
+		}
 
 	private:
-		struct DataPointerProducer {
-			virtual PointerType *make_data_pointer(StorageArray &data) const = 0;
-			virtual const PointerType *make_const_data_pointer(const StorageArray &data) const = 0;
-		};
-
-		template<typename T>
-		class DataPointerProducerImpl : public DataPointerProducer {
-		public:
-			PointerType *make_data_pointer(StorageArray &data) const override
+		void copy_from(const UnionBase<Types...> &other)
+		{
+			if (other.data_valid())
 			{
-				return &static_cast<PointerType&>(reinterpret_cast<T&>(*data));
+				kCopiers[other.index_](other.data_, data_);
+				index_ = other.index_;
 			}
+		}
 
-			const PointerType *make_const_data_pointer(const StorageArray &data) const override
+		// like std::variant, other keeps its (moved-from) value
+		void move_from(UnionBase<Types...> &other)
+		{
+			if (other.data_valid())
 			{
-				return &static_cast<const PointerType&>(reinterpret_cast<const T&>(*data));
+				kMovers[other.index_](other.data_, data_);
+				index_ = other.index_;
 			}
-		};
-
-		template<typename T>
-		static DataPointerProducer *data_pointer_producer_dispatch()
-		{
-			static DataPointerProducerImpl<T> data_pointer_producer{};
-			return &data_pointer_producer;
 		}
 
-	public:
-		template<typename = std::enable_if_t<impl::are_types_valid_for_union<Types...>()>>
-		UnionWithDataPtr()
-			: BaseType{}
-			, data_pointer_producer_{nullptr}
-		{
-		}
+		alignas(Types...) StorageArray data_;
+		Index                          index_;
+	};
 
-		template<typename T,
-			typename = std::enable_if_t<impl::are_types_valid_for_union<Types...>()>,
-			typename = std::enable_if_t<impl::enable_set_v<T, Types...>>>
-			UnionWithDataPtr(const T &data)
-			: BaseType{ data }
-			, data_pointer_producer_{data_pointer_producer_dispatch<T>()}
-		{
-		}
+	template<typename ...Types>
+	constexpr typename UnionBase<Types...>::DestroyFunction UnionBase<Types...>::kDestroyers[];
 
-		UnionWithDataPtr(const UnionWithDataPtr<PointerType, Types...> &other)
-			: BaseType{ other }
-			, data_pointer_producer_{other.data_pointer_producer_}
-		{
-		}
+	template<typename ...Types>
+	constexpr typename UnionBase<Types...>::CopyFunction UnionBase<Types...>::kCopiers[];
 
-		virtual ~UnionWithDataPtr()
-		{
-		}
+	template<typename ...Types>
+	constexpr typename UnionBase<Types...>::MoveFunction UnionBase<Types...>::kMovers[];
 
-		template <typename T,
-			typename = std::enable_if_t<impl::enable_set_v<T, Types...>>>
-			void set(const T &data)
-		{
-			data_pointer_producer_ = data_pointer_producer_dispatch<T>();
-			ParentType::set(data);
-		}
+	template<typename ...Types>
+	using Union = UnionBase<Types...>;
+
+	// a union of types which share the base PTR_TYPE, which can be accessed
+	// without knowing the held type
+	template<typename PTR_TYPE, typename ...Types>
+	class UnionWithDataPtr : public UnionBase<Types...>
+	{
+	public:
+		using BaseType = UnionBase<Types...>;
+		using PointerType = PTR_TYPE;
+
+		using BaseType::BaseType;
 
 		PointerType *get_data_ptr()
 		{
-			if (!data_valid())
+			if (!BaseType::data_valid())
 			{
 				return nullptr;
 			}
 
-
-			ASSERT(data_pointer_producer_, "No data pointer producer defined");
-			return data_pointer_producer_->make_data_pointer(data());
+			return BaseType::visit([](PointerType &data) { return &data; });
 		}
 
 		const PointerType *get_const_data_ptr() const
 		{
-			if (!data_valid())
+			if (!BaseType::data_valid())
 			{
 				return nullptr;
 			}
 
-
-			ASSERT(data_pointer_producer_, "No data pointer producer defined");
-			return data_pointer_producer_->make_const_data_pointer(data());
+			return BaseType::visit([](const PointerType &data) { return &data; });
 		}
-
-	private:
-		DataPointerProducer *data_pointer_producer_;
 	}; // class UnionWithDataPtr
 } // namespace util
 
@@ -0,0 +1,138 @@
+#include "wav_decoder.h"
+
+#include "logging.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace util {
+
+namespace {
+	constexpr uint16_t kPcmFormat{ 1 };
+
+	uint16_t read_u16(const unsigned char *data)
+	{
+		return static_cast<uint16_t>(data[0] | (data[1] << 8));
+	}
+
+	uint32_t read_u32(const unsigned char *data)
+	{
+		return static_cast<uint32_t>(data[0]) | (static_cast<uint32_t>(data[1]) << 8) |
+			(static_cast<uint32_t>(data[2]) << 16) | (static_cast<uint32_t>(data[3]) << 24);
+	}
+
+	int16_t read_sample(const unsigned char *data, const uint16_t bits_per_sample)
+	{
+		// 8-bit samples are unsigned, 16-bit signed
+		return (bits_per_sample == 8) ?
+			static_cast<int16_t>((static_cast<int>(data[0]) - 128) * 256) :
+			static_cast<int16_t>(read_u16(data));
+	}
+} // namespace
+
+bool read_wav_header(std::istream &file, const char *path, WavFormat &format)
+{
+	unsigned char riff_header[12];
+	if (!file.read(reinterpret_cast<char*>(riff_header), sizeof(riff_header)) ||
+		std::memcmp(riff_header, "RIFF", 4) != 0 || std::memcmp(riff_header + 8, "WAVE", 4) != 0)
+	{
+		LOG_WARNING("Not a .wav file: " << path);
+		return false;
+	}
+
+	// walk the chunks for the format & then the samples; anything else is skipped
+	uint16_t encoding = 0;
+	uint32_t sample_rate = 0;
+	format = WavFormat{ 0, 0, 0 };
+	unsigned char chunk_header[8];
+	while (file.read(reinterpret_cast<char*>(chunk_header), sizeof(chunk_header)))
+	{
+		const auto chunk_size = read_u32(chunk_header + 4);
+		if (std::memcmp(chunk_header, "fmt ", 4) == 0 && chunk_size >= 16)
+		{
+			unsigned char format_chunk[16];
+			if (!file.read(reinterpret_cast<char*>(format_chunk), sizeof(format_chunk)))
+			{
+				break;
+			}
+			encoding = read_u16(format_chunk);
+			format.channels_ = read_u16(format_chunk + 2);
+			sample_rate = read_u32(format_chunk + 4);
+			format.bits_per_sample_ = read_u16(format_chunk + 14);
+			// chunks are padded to an even size
+			file.seekg(chunk_size - sizeof(format_chunk) + (chunk_size & 1), std::ios::cur);
+		}
+		else if (std::memcmp(chunk_header, "data", 4) == 0)
+		{
+			if (encoding != kPcmFormat || (format.channels_ != 1 && format.channels_ != 2) ||
+				(format.bits_per_sample_ != 8 && format.bits_per_sample_ != 16) || sample_rate != kPcmSampleRate)
+			{
+				// the mixer doesn't resample, so other rates are rejected
+				LOG_WARNING("Unsupported .wav format in " << path << " (format " << encoding << ", "
+					<< format.channels_ << " channels, " << format.bits_per_sample_ << " bits, " << sample_rate << "Hz)");
+				return false;
+			}
+
+			format.frames_ = chunk_size / (format.bits_per_sample_ / 8 * format.channels_);
+			return true;
+		}
+		else
+		{
+			file.seekg(chunk_size + (chunk_size & 1), std::ios::cur);
+		}
+	}
+
+	LOG_WARNING("No samples in .wav file: " << path);
+	return false;
+}
+
+size_t decode_wav_frames(std::istream &file, const WavFormat &format, int16_t *pcm, const size_t frames)
+{
+	// read through a small buffer, so decoding takes no more memory for longer files
+	static constexpr size_t kReadSize{ 4096 };
+	unsigned char bytes[kReadSize];
+
+	const size_t bytes_per_sample = format.bits_per_sample_ / 8;
+	const auto bytes_per_frame = bytes_per_sample * format.channels_;
+	size_t decoded = 0;
+	while (decoded < frames)
+	{
+		const auto wanted = std::min(frames - decoded, kReadSize / bytes_per_frame);
+		file.read(reinterpret_cast<char*>(bytes), wanted * bytes_per_frame);
+		const auto read = static_cast<size_t>(file.gcount()) / bytes_per_frame;
+		for (size_t frame = 0; frame < read; ++frame)
+		{
+			const auto source = bytes + frame * bytes_per_frame;
+			const auto left = read_sample(source, format.bits_per_sample_);
+			const auto right = (format.channels_ == 2) ? read_sample(source + bytes_per_sample, format.bits_per_sample_) : left;
+			pcm[(decoded + frame) * kPcmChannels] = left;
+			pcm[(decoded + frame) * kPcmChannels + 1] = right;
+		}
+
+		decoded += read;
+		if (read < wanted)
+		{
+			break;
+		}
+	}
+	return decoded;
+}
+
+bool decode_wav(const char *path, PcmBuffer &pcm)
+{
+	pcm.clear();
+
+	std::ifstream file{ path, std::ios::binary };
+	WavFormat format;
+	if (!read_wav_header(file, path, format))
+	{
+		return false;
+	}
+
+	pcm.resize(format.frames_ * kPcmChannels);
+	pcm.resize(decode_wav_frames(file, format, pcm.data(), format.frames_) * kPcmChannels);
+	return true;
+}
+
+} // namespace util
\ No newline at end of file
@@ -0,0 +1,39 @@
+#ifndef WAV_DECODER_H
+#define WAV_DECODER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+
+namespace util {
+
+// Decoded audio, as the mixer wants it: interleaved 16-bit stereo samples at
+// kPcmSampleRate
+constexpr unsigned int kPcmSampleRate{ 44100 };
+constexpr size_t       kPcmChannels{ 2 };
+using PcmBuffer = std::vector<int16_t>;
+
+// Supported .wav files are uncompressed (PCM) 8- or 16-bit mono or stereo
+// at kPcmSampleRate; mono is duplicated to both channels
+struct WavFormat {
+	uint16_t channels_;
+	uint16_t bits_per_sample_;
+	size_t   frames_; // in the file
+};
+
+// Reads a .wav file's header, leaving file at its first sample.  Returns
+// false for anything that isn't a supported .wav file
+bool read_wav_header(std::istream &file, const char *path, WavFormat &format);
+
+// Decodes up to frames frames from a file positioned by read_wav_header() &
+// returns how many were decoded.  Callers stop at format.frames_ in total;
+// whatever follows the samples in the file isn't audio
+size_t decode_wav_frames(std::istream &file, const WavFormat &format, int16_t *pcm, size_t frames);
+
+// Decodes a whole file; returns false (leaving pcm empty) if it isn't supported
+bool decode_wav(const char *path, PcmBuffer &pcm);
+
+} // namespace util
+
+#endif // WAV_DECODER_H
\ No newline at end of file
@@ -0,0 +1,143 @@
+#include "worker_pool.h"
+
+#include "logging.h"
+
+#include <algorithm>
+
+namespace util {
+
+constexpr size_t WorkerPool::kMaxThreads;
+
+std::thread             *WorkerPool::workers_{ nullptr };
+size_t                  WorkerPool::worker_count_{ 0 };
+std::mutex              WorkerPool::mutex_{};
+std::condition_variable WorkerPool::work_ready_{};
+std::condition_variable WorkerPool::work_done_{};
+uint64_t                WorkerPool::generation_{ 0 };
+bool                    WorkerPool::stopping_{ false };
+
+WorkerPool::Task WorkerPool::task_{ nullptr };
+void             *WorkerPool::context_{ nullptr };
+size_t           WorkerPool::count_{ 0 };
+size_t           WorkerPool::chunk_count_{ 0 };
+size_t           WorkerPool::chunk_size_{ 0 };
+size_t           WorkerPool::chunks_pending_{ 0 };
+
+size_t WorkerPool::thread_count()
+{
+	// hardware_concurrency() can cost a system call, & this is asked every parallel_for
+	static const size_t kThreadCount{ std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), kMaxThreads) };
+	return kThreadCount;
+}
+
+void WorkerPool::run(const Task task, void *context, const size_t count, const size_t chunk_count)
+{
+	ASSERT(chunk_count > 0 && chunk_count <= thread_count(), "Invalid chunk count");
+	if (chunk_count == 1)
+	{
+		task(context, 0, count);
+		return;
+	}
+
+	if (!workers_)
+	{
+		start();
+	}
+
+	{
+		std::lock_guard<std::mutex> lock{ mutex_ };
+		ASSERT(chunks_pending_ == 0, "WorkerPool runs can't overlap");
+		task_ = task;
+		context_ = context;
+		count_ = count;
+		chunk_count_ = chunk_count;
+		chunk_size_ = (count + chunk_count - 1) / chunk_count;
+		chunks_pending_ = chunk_count - 1;
+		++generation_;
+	}
+	work_ready_.notify_all();
+
+	run_chunk(0);
+
+	std::unique_lock<std::mutex> lock{ mutex_ };
+	work_done_.wait(lock, []() { return chunks_pending_ == 0; });
+}
+
+void WorkerPool::shutdown()
+{
+	if (!workers_)
+	{
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock{ mutex_ };
+		stopping_ = true;
+	}
+	work_ready_.notify_all();
+
+	for (size_t worker = 0; worker < worker_count_; ++worker)
+	{
+		workers_[worker].join();
+	}
+	delete[] workers_;
+	workers_ = nullptr;
+	worker_count_ = 0;
+	stopping_ = false;
+}
+
+void WorkerPool::start()
+{
+	// the threads are joined by shutdown() rather than by a static destructor, which
+	// would run after main() returns
+	worker_count_ = thread_count() - 1;
+	workers_ = new std::thread[worker_count_];
+	for (size_t worker = 0; worker < worker_count_; ++worker)
+	{
+		workers_[worker] = std::thread{ &WorkerPool::worker_main, worker };
+	}
+}
+
+void WorkerPool::worker_main(const size_t worker)
+{
+	// worker n runs chunk n + 1 of any run w/ that many chunks
+	const auto chunk = worker + 1;
+	uint64_t last_generation{ 0 };
+	for (;;)
+	{
+		{
+			std::unique_lock<std::mutex> lock{ mutex_ };
+			work_ready_.wait(lock, [last_generation]() { return stopping_ || generation_ != last_generation; });
+			if (stopping_)
+			{
+				return;
+			}
+
+			last_generation = generation_;
+			if (chunk >= chunk_count_)
+			{
+				continue;
+			}
+		}
+
+		run_chunk(chunk);
+
+		std::lock_guard<std::mutex> lock{ mutex_ };
+		if (--chunks_pending_ == 0)
+		{
+			work_done_.notify_one();
+		}
+	}
+}
+
+void WorkerPool::run_chunk(const size_t chunk)
+{
+	const auto begin = std::min(count_, chunk * chunk_size_);
+	const auto end = std::min(count_, begin + chunk_size_);
+	if (begin < end)
+	{
+		task_(context_, begin, end);
+	}
+}
+
+} // namespace util
\ No newline at end of file
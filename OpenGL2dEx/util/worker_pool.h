@@ -0,0 +1,62 @@
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+namespace util {
+
+// Threads that are started once & then woken to run chunks of a task, so that
+// splitting work over threads costs a wake-up (a few microseconds) rather than
+// creating & joining threads every time.  Nothing is allocated per run.
+// Used through parallel_for(); runs may only be issued from one thread at a time
+class WorkerPool {
+public:
+	using Task = void (*)(void *context, size_t begin, size_t end);
+
+	static constexpr size_t kMaxThreads{ 16 };
+
+	// threads a run can use, the calling thread included
+	static size_t thread_count();
+
+	// calls task(context, begin, end) for chunk_count contiguous chunks covering
+	// [0, count) & returns once all are done; the calling thread runs the first.
+	// The workers are started by the first run
+	static void run(Task task, void *context, size_t count, size_t chunk_count);
+
+	// joins the workers; call before exiting
+	static void shutdown();
+
+private:
+	// singleton
+	WorkerPool()
+	{
+	}
+
+	static void start();
+	static void worker_main(size_t worker);
+	static void run_chunk(size_t chunk);
+
+	static std::thread             *workers_; // thread_count() - 1 of them, or nullptr
+	static size_t                  worker_count_;
+	static std::mutex              mutex_;
+	static std::condition_variable work_ready_;
+	static std::condition_variable work_done_;
+	static uint64_t                generation_; // bumped by every run, under mutex_
+	static bool                    stopping_;
+
+	// the current run; written under mutex_ before generation_ is bumped
+	static Task   task_;
+	static void   *context_;
+	static size_t count_;
+	static size_t chunk_count_;
+	static size_t chunk_size_;
+	static size_t chunks_pending_; // worker chunks not yet finished
+}; // class WorkerPool
+
+} // namespace util
+
+#endif // WORKER_POOL_H
\ No newline at end of file